@@ -16,18 +16,22 @@
 
         "src/concurrent_deque.hpp",
         "src/event_loop_dispatcher.hpp",
+        "src/js_batch_listener.hpp",
         "src/js_class.hpp",
         "src/js_collection.hpp",
+        "src/js_file_operation.hpp",
         "src/js_list.hpp",
         "src/js_object_accessor.hpp",
         "src/js_observable.hpp",
         "src/js_realm.hpp",
         "src/js_realm_object.hpp",
         "src/js_results.hpp",
+        "src/js_results_window.hpp",
         "src/js_schema.hpp",
         "src/js_sync.hpp",
         "src/js_types.hpp",
         "src/js_util.hpp",
+        "src/listener_registry.hpp",
         "src/node/node_class.hpp",
         "src/node/node_context.hpp",
         "src/node/node_exception.hpp",
@@ -39,8 +43,12 @@
         "src/node/node_string.hpp",
         "src/node/node_types.hpp",
         "src/node/node_value.hpp",
+        "src/notification_scheduler.hpp",
+        "src/notification_throttle.hpp",
         "src/platform.hpp",
         "src/rpc.hpp",
+        "src/rpc_cbor.hpp",
+        "src/thread_pool.hpp",
       ],
       "include_dirs": [
         "src"
@@ -81,10 +89,12 @@
         "lib/index.js",
         "lib/management-schema.js",
         "lib/permission-api.js",
+        "lib/sharded.js",
         "lib/submit-analytics.js",
         "lib/user-methods.js",
 
         "lib/browser/base64.js",
+        "lib/browser/cbor.js",
         "lib/browser/collections.js",
         "lib/browser/constants.js",
         "lib/browser/index.js",
@@ -139,6 +149,7 @@
         "tests/js/results-tests.js",
         "tests/js/schemas.js",
         "tests/js/session-tests.js",
+        "tests/js/sharded-tests.js",
         "tests/js/user-tests.js",
         "tests/js/worker-tests-script.js",
         "tests/js/worker.js",
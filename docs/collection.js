@@ -275,11 +275,12 @@ class Collection {
      * are ignored entirely by this method and will not be returned.
      *
      * @param {string} [property] - For a collection of objects, the property to take the minimum of.
+     * @param {Realm.Collection~AggregateOptions} [options] - Only supported together with `property`.
      * @throws {Error} If no property with the name exists or if property is not numeric/date.
      * @returns {number} the minimum value.
      * @since 1.12.1
      */
-    min(property) {}
+    min(property, options) {}
 
     /**
      * Returns the maximum value of the values in the collection or of the
@@ -290,11 +291,12 @@ class Collection {
      * are ignored entirely by this method and will not be returned.
      *
      * @param {string} [property] - For a collection of objects, the property to take the maximum of.
+     * @param {Realm.Collection~AggregateOptions} [options] - Only supported together with `property`.
      * @throws {Error} If no property with the name exists or if property is not numeric/date.
      * @returns {number} the maximum value.
      * @since 1.12.1
      */
-    max(property) {}
+    max(property, options) {}
 
     /**
      * Computes the sum of the values in the collection or of the given
@@ -304,11 +306,12 @@ class Collection {
      * Only supported for int, float and double properties. `null` values are
      * ignored entirely by this method.
      * @param {string} [property] - For a collection of objects, the property to take the sum of.
+     * @param {Realm.Collection~AggregateOptions} [options] - Only supported together with `property`.
      * @throws {Error} If no property with the name exists or if property is not numeric.
      * @returns {number} the sum.
      * @since 1.12.1
      */
-    sum(property) {}
+    sum(property, options) {}
 
     /**
      * Computes the average of the values in the collection or of the given
@@ -318,11 +321,21 @@ class Collection {
      * Only supported for int, float and double properties. `null` values are
      * ignored entirely by this method and will not be factored into the average.
      * @param {string} [property] - For a collection of objects, the property to take the average of.
+     * @param {Realm.Collection~AggregateOptions} [options] - Only supported together with `property`.
      * @throws {Error} If no property with the name exists or if property is not numeric.
      * @returns {number} the sum.
      * @since 1.12.1
      */
-    avg(property) {}
+    avg(property, options) {}
+
+    /**
+     * Counts the objects in the collection, which is the same as its `length`. Unlike `length`, the
+     * objects matched by the query of a large {@link Realm.Results} can be counted on several threads.
+     * @param {Realm.Collection~AggregateOptions} [options]
+     * @returns {number} the number of objects in the collection.
+     * @since 2.16.0
+     */
+    count(options) {}
 
     /**
      * @see {@link https://developer.mozilla.org/en-US/docs/Web/JavaScript/Reference/Global_Objects/Array/forEach Array.prototype.forEach}
@@ -432,7 +445,23 @@ class Collection {
      *      inserted, updated or deleted respectively. `deletions` and `oldModifications` are
      *      indices into the collection before the change happened, while `insertions` and
      *      `newModifications` are indices into the new version of the collection.
-     * @throws {Error} If `callback` is not a function.
+     * @param {Object} [options]
+     * @param {string} [options.indexFormat='array'] - How the indices in `changes` are delivered:
+     *   - `'array'`: an array of numbers,
+     *   - `'uint32'`: a `Uint32Array` of indices,
+     *   - `'ranges'`: a `Uint32Array` of `start, count` pairs, one pair for each run of consecutive
+     *     indices. This stays small for large bulk changes, such as deleting many objects at once.
+     * @param {number} [options.throttleMs] - Call the listener at most once in this many milliseconds.
+     *   Changes that happen in between are merged into a single change set.
+     * @param {number} [options.debounceMs] - Only call the listener once no changes happened for this
+     *   many milliseconds, with the changes since the last call merged. If `throttleMs` is given as
+     *   well, the listener is called at least that often while changes keep coming.
+     * @param {number} [options.priority=0] - When a notification budget is set with
+     *   {@link Realm.setNotificationBudget}, listeners with a higher priority are called first.
+     * @param {boolean} [options.weak=false] - Do not keep `callback`, or the collection it was added to,
+     *   from being garbage collected. Once either is collected the listener is removed, and the
+     *   notifications behind it stop. On JavaScriptCore the listener is held strongly.
+     * @throws {Error} If `callback` is not a function or `options` are invalid.
      * @example
      * wines.addListener((collection, changes) => {
      *  // collection === wines
@@ -441,8 +470,14 @@ class Collection {
      *  console.log(`${changes.deletions.length} deletions`);
      *  console.log(`new size of collection: ${collection.length}`);
      * });
+     * @example
+     * wines.addListener((collection, changes) => {
+     *  for (let i = 0; i < changes.deletions.length; i += 2) {
+     *    console.log(`deleted ${changes.deletions[i + 1]} wines at ${changes.deletions[i]}`);
+     *  }
+     * }, { indexFormat: 'ranges' });
      */
-    addListener(callback) {}
+    addListener(callback, options) {}
 
     /**
      * Remove the listener `callback` from the collection instance.
@@ -485,3 +520,17 @@ class Collection {
  * @memberof Realm.Collection
  * @type {string|Array}
  */
+
+/**
+ * Options for {@link Realm.Collection#min min()}, {@link Realm.Collection#max max()},
+ * {@link Realm.Collection#sum sum()}, {@link Realm.Collection#avg avg()} and
+ * {@link Realm.Collection#count count()}.
+ * @typedef Realm.Collection~AggregateOptions
+ * @memberof Realm.Collection
+ * @type {Object}
+ * @property {boolean} [parallel=false] - Compute the aggregate of a large {@link Realm.Results}
+ *   on several threads, each reading a separate part of the table at the same version. Aggregates
+ *   over lists, snapshots, results using `DISTINCT`, properties other than int, float and double,
+ *   small tables and aggregates inside a write transaction are computed on the calling thread. Results
+ *   without a query already know their count.
+ */
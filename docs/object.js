@@ -54,4 +54,47 @@ class Object {
      * @since 2.6.0
      */
     linkingObjectsCount() {}
+
+    /**
+     * Add a listener `callback` which will be called when this object changes or is deleted.
+     * @param {function(object, changes)} callback - A function to be called when changes occur.
+     *   The callback function is called with two arguments:
+     *   - `object`: the object that changed,
+     *   - `changes`: a dictionary with the keys `deleted`, which is `true` if the object was
+     *     deleted, and `changedProperties`, the names of the properties that changed.
+     * @param {Object} [options]
+     * @param {string[]} [options.keyPaths] - Only notify about changes to these properties. Properties
+     *   of linked objects are named with key paths such as `'owner.name'`.
+     * @param {number} [options.priority=0] - When a notification budget is set with
+     *   {@link Realm.setNotificationBudget}, listeners with a higher priority are called first.
+     * @param {boolean} [options.weak=false] - Do not keep `callback`, or the object it was added to,
+     *   from being garbage collected. Once either is collected the listener is removed, and the
+     *   notifications behind it stop. On JavaScriptCore the listener is held strongly.
+     * @throws {Error} If `callback` is not a function or `options` are invalid.
+     * @example
+     * wine.addListener((wine, changes) => {
+     *  if (changes.deleted) {
+     *    console.log('wine was deleted');
+     *  } else {
+     *    console.log(`${changes.changedProperties.join(', ')} changed`);
+     *  }
+     * });
+     * @since 2.16.0
+     */
+    addListener(callback, options) {}
+
+    /**
+     * Remove the listener `callback` from this object.
+     * @param {function(object, changes)} callback - Callback function that was previously
+     *   added as a listener through the {@link Realm.Object#addListener addListener} method.
+     * @throws {Error} If `callback` is not a function.
+     * @since 2.16.0
+     */
+    removeListener(callback) {}
+
+    /**
+     * Remove all listeners from this object.
+     * @since 2.16.0
+     */
+    removeAllListeners() {}
 }
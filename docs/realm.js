@@ -228,9 +228,13 @@ class Realm {
      * @param {callback(Realm, string)|callback(Realm, string, Schema)} callback - Function to be called when a change event occurs.
      *   Each callback will only be called once per event, regardless of the number of times
      *   it was added.
+     * @param {Object} [options] - Options for "change" listeners:
+     * @param {number} [options.throttleMs] - Call the listener at most once in this many milliseconds.
+     * @param {number} [options.debounceMs] - Only call the listener once no changes happened for this
+     *   many milliseconds.
      * @throws {Error} If an invalid event `name` is supplied, or if `callback` is not a function.
      */
-    addListener(name, callback) {}
+    addListener(name, callback, options) {}
 
    /**
     * Remove the listener `callback` for the specfied event `name`.
@@ -250,6 +254,30 @@ class Realm {
     */
     removeAllListeners(name) {}
 
+    /**
+     * Add a listener `callback` which is called once with the changes of all of the given
+     * collections and objects, instead of once for each of them. The changes that the objects
+     * store delivers for a new version of the Realm are collected, and handed to the callback on
+     * the next turn of the event loop.
+     * @param {callback(Realm, Array)} callback - Function to be called when any of the `objects`
+     *   change. It is called with the Realm and an array with an entry for each change, with the keys:
+     *   - `object`: the collection or object that changed,
+     *   - `changes`: the changes, as given to {@link Realm.Collection#addListener Realm.Collection.addListener()}
+     *     or {@link Realm.Object#addListener Realm.Object.addListener()} listeners.
+     * @param {Array<Realm.Collection|Realm.Object>} objects - The collections and objects to observe.
+     * @throws {Error} If `callback` is not a function, or `objects` contains anything other than
+     *   Realm objects, results and lists.
+     * @since 2.16.0
+     */
+    addBatchListener(callback, objects) {}
+
+    /**
+     * Remove a listener that was added with {@link Realm#addBatchListener addBatchListener()}.
+     * @param {callback(Realm, Array)} callback
+     * @since 2.16.0
+     */
+    removeBatchListener(callback) {}
+
    /**
     * Synchronously call the provided `callback` inside a write transaction.
     * @param {function()} callback
@@ -302,6 +330,64 @@ class Realm {
      */
     writeCopyTo(path, encryptionKey) {}
 
+    /**
+     * Writes a compacted copy of the Realm to the given path on a background thread.
+     *
+     * The destination file cannot already exist. The copy contains the data of the latest committed
+     * write transaction; changes in a write transaction which is in progress are not included.
+     *
+     * Background file operations are run one at a time, in the order they were scheduled. They are not
+     * supported when debugging in Chrome, where the promise is rejected.
+     * @param {string} path - path to save the Realm to
+     * @param {ArrayBuffer|ArrayBufferView} [encryptionKey] - Optional 64-byte encryption key to encrypt the new file with.
+     * @param {Realm~FileOperationOptions} [options]
+     * @returns {Promise<boolean>} - a promise resolved once the copy has been written. The promise has a
+     *   `cancel()` method, which skips the operation if it has not started yet, or removes the copy once
+     *   it has been written. Either way the promise is rejected.
+     * @since 2.16.0
+     */
+    writeCopyToAsync(path, encryptionKey, options) {}
+
+    /**
+     * Create a reference to a Realm object or collection which can be passed to another thread, for
+     * example with `postMessage()` to a `worker_threads` worker, and resolved there with
+     * {@link Realm#resolveThreadSafeReference resolveThreadSafeReference()}.
+     *
+     * The reference pins the current version of the Realm until it has been resolved, so every
+     * reference should be resolved exactly once. A reference which will not be resolved must be released
+     * with {@link Realm.releaseThreadSafeReference Realm.releaseThreadSafeReference()}, as it is otherwise
+     * kept until the process exits. Cannot be called from a write transaction.
+     * @param {Realm.Object|Realm.Results|Realm.List} object - the object or collection to hand over.
+     * @returns {Object} a plain object identifying the reference.
+     * @throws {Error} If `object` is invalid or this Realm is in a write transaction.
+     * @since 2.16.0
+     */
+    createThreadSafeReference(object) {}
+
+    /**
+     * Resolve a reference created by {@link Realm#createThreadSafeReference createThreadSafeReference()},
+     * possibly on another thread. The Realm must be opened at the same path as the one which created
+     * the reference, and is advanced to the version of the reference if it is older. Results are not
+     * re-evaluated by resolving them.
+     * @param {Object} reference - the object returned by `createThreadSafeReference()`.
+     * @returns {Realm.Object|Realm.Results|Realm.List} the object or collection in this Realm. An object
+     *   which has since been deleted is returned as an invalid object.
+     * @throws {Error} If the reference has already been resolved.
+     * @since 2.16.0
+     */
+    resolveThreadSafeReference(reference) {}
+
+    /**
+     * Release a reference created by {@link Realm#createThreadSafeReference createThreadSafeReference()}
+     * without resolving it, which unpins the version of the Realm it refers to. The reference can no
+     * longer be resolved afterwards.
+     * @param {Object} reference - the object returned by `createThreadSafeReference()`.
+     * @returns {boolean} `true` if the reference was released, or `false` if it had already been
+     *   resolved or released.
+     * @since 2.16.0
+     */
+    static releaseThreadSafeReference(reference) {}
+
     /**
      * Get the current schema version of the Realm at the given path.
      * @param {string} path - The path to the file where the
@@ -313,13 +399,66 @@ class Realm {
      */
     static schemaVersion(path, encryptionKey) {}
 
+    /**
+     * Limit the time spent calling collection and object listeners in one turn of the event loop.
+     * Once `budgetMs` milliseconds have been spent, the remaining listeners are called on a later
+     * turn, so that other work such as rendering or handling requests is not held up by large
+     * batches of notifications. Listeners which are waiting receive the changes since their last
+     * call merged into one change set. At least one listener is called per turn. The budget
+     * applies to the listeners of the current thread.
+     * @param {number} budgetMs - The time budget in milliseconds, or `0` (the default) to call
+     *   listeners as soon as their notifications arrive.
+     * @throws {Error} If `budgetMs` is negative.
+     * @since 2.16.0
+     */
+    static setNotificationBudget(budgetMs) {}
+
+    /**
+     * Get statistics about the listener calls of the current thread, to help tune
+     * {@link Realm.setNotificationBudget}.
+     * @returns {Object} an object with the properties:
+     *   - `ticks`: the number of turns of the event loop which called queued listeners,
+     *   - `delivered`: the number of listener calls,
+     *   - `deferred`: how often a listener was left for a later turn because the budget was spent,
+     *   - `lastTickMs`, `maxTickMs` and `totalTickMs`: the time spent calling queued listeners in
+     *     the last turn, the longest turn and all turns.
+     * @since 2.16.0
+     */
+    static notificationMetrics() {}
+
     /**
      * Delete the Realm file for the given configuration.
      * @param {Realm~Configuration} config
      * @throws {Error} If anything in the provided `config` is invalid.
      */
     static deleteFile(config) {}
+
+    /**
+     * Compact the Realm file for the given configuration on a background thread.
+     *
+     * Compaction will not occur if other `Realm` instances for the file exist, in which case the
+     * promise is resolved with `false`.
+     *
+     * Background file operations are run one at a time, in the order they were scheduled. They are not
+     * supported when debugging in Chrome, where the promise is rejected.
+     * @param {Realm~Configuration} [config] - only `path` and `encryptionKey` are used.
+     * @param {Realm~FileOperationOptions} [options]
+     * @returns {Promise<boolean>} - a promise resolved with `true` if compaction succeeds. The promise
+     *   has a `cancel()` method which skips the compaction if it has not started yet, in which case the
+     *   promise is rejected. A compaction which has started cannot be cancelled, and `cancel()` returns `false`.
+     * @since 2.16.0
+     */
+    static compactAsync(config, options) {}
 }
+
+/**
+ * Options for background file operations such as {@link Realm.compactAsync}.
+ * @typedef Realm~FileOperationOptions
+ * @type {Object}
+ * @property {callback(transferred, transferable)} [onProgress] - called periodically with the number
+ *   of bytes written so far and the expected total number of bytes.
+ * @property {number} [progressInterval=100] - interval in milliseconds between progress reports.
+ */
 /**
  * This describes the different options used to create a {@link Realm} instance.
  * @typedef Realm~Configuration
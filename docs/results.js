@@ -36,4 +36,84 @@ class Results extends Collection {
      * @since 2.0.0-rc20
      */
     update(property, value) {}
+
+    /**
+     * Create a live view of `count` objects starting at index `start` of these results, such as
+     * the rows visible in a virtualized list. Only the objects in the window are read, and its
+     * listeners are only called when those objects change.
+     * @param {number} start - The index of the first object in the window.
+     * @param {number} count - The number of objects in the window.
+     * @returns {Realm.Results.Window}
+     * @throws {Error} If `start` or `count` is not a non-negative integer.
+     * @example
+     * const visible = wines.window(0, 20);
+     * visible.addListener((visible, changes) => {
+     *   // changes.insertions, deletions and modifications are indices into the window.
+     * });
+     * // When the list is scrolled:
+     * visible.move(40);
+     * @since 2.16.0
+     */
+    window(start, count) {}
+}
+
+/**
+ * A live view of a range of {@link Realm.Results}, created by {@link Realm.Results#window window()}.
+ * The window stays at the same indices while the results change, so objects move in and out of it
+ * as objects are inserted and deleted before it.
+ * @memberof Realm.Results
+ * @since 2.16.0
+ */
+class Window {
+    /**
+     * The number of objects in the window, which is less than `count` at the end of the results.
+     * @type {number}
+     * @readonly
+     */
+    get length() {}
+
+    /**
+     * The index of the first object of the window in the results.
+     * @type {number}
+     * @readonly
+     */
+    get start() {}
+
+    /**
+     * The maximum number of objects in the window.
+     * @type {number}
+     * @readonly
+     */
+    get count() {}
+
+    /**
+     * Move the window without reading any objects. Listeners are not called for the move itself.
+     * @param {number} start - The index of the new first object of the window.
+     * @param {number} [count] - The new number of objects in the window, if it changes.
+     * @throws {Error} If `start` or `count` is not a non-negative integer.
+     */
+    move(start, count) {}
+
+    /**
+     * Add a listener `callback` which is called when the objects in the window change. Objects
+     * which are moved into or out of the window by changes outside of it are reported as inserted
+     * or deleted, and all indices are relative to the start of the window.
+     * @param {function(window, changes)} callback - Called with the window and the changes, as
+     *   with {@link Realm.Collection#addListener Realm.Collection.addListener()}.
+     * @param {Object} [options] - The `indexFormat`, `priority` and `weak` options of
+     *   {@link Realm.Collection#addListener Realm.Collection.addListener()}.
+     * @throws {Error} If `callback` is not a function or `options` are invalid.
+     */
+    addListener(callback, options) {}
+
+    /**
+     * Remove the listener `callback` from the window.
+     * @param {function(window, changes)} callback
+     */
+    removeListener(callback) {}
+
+    /**
+     * Remove all listeners from the window.
+     */
+    removeAllListeners() {}
 }
@@ -0,0 +1,191 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2018 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A sharded Realm partitions one logical dataset across several Realm files. Each object is
+ * stored in the shard chosen by the `shardKey` function of the configuration, so writes to
+ * different shards do not wait for each other and every file can be compacted on its own.
+ *
+ * The shards are opened at `<path>.shard-<index>.realm` with the remaining configuration.
+ * @memberof Realm
+ * @since 2.16.0
+ */
+class Sharded {
+    /**
+     * Open the shards of a sharded Realm.
+     * @param {Realm~Configuration} config - a Realm configuration which additionally contains:
+     * @param {number} config.shardCount - the number of shards. This must not change once objects
+     *   have been stored.
+     * @param {callback(objectType, properties)} config.shardKey - returns the shard key of an object
+     *   of the given type with the given properties. Numbers are used as is, any other value is
+     *   hashed. For {@link Realm.Sharded#objectForPrimaryKey objectForPrimaryKey()} it is called
+     *   with only the primary key; if it returns `undefined` all shards are searched.
+     * @throws {Error} If anything in the provided `config` is invalid.
+     */
+    constructor(config) {}
+
+    /**
+     * The Realm instances of the shards.
+     * @type {Realm[]}
+     * @readonly
+     */
+    get shards() {}
+
+    /**
+     * Returns the index of the shard an object of the given type and properties is stored in, or `-1`
+     * if the shard key cannot be determined.
+     * @param {string} objectType
+     * @param {Object} properties
+     * @returns {number}
+     * @throws {Error} If the shard key is `NaN` or an infinite number.
+     */
+    shardIndex(objectType, properties) {}
+
+    /**
+     * Synchronously call the provided callback inside a write transaction. A transaction is only
+     * begun on a shard once the callback creates or deletes an object in it, and each shard is
+     * committed separately, so changes spanning several shards are not atomic.
+     * @param {function()} callback
+     * @returns {any} the value returned by the callback.
+     */
+    write(callback) {}
+
+    /**
+     * Create a new Realm object in the shard selected by its shard key.
+     * @param {Realm~ObjectType} type
+     * @param {Object} properties
+     * @param {boolean} [update=false]
+     * @returns {Realm.Object}
+     */
+    create(type, properties, update) {}
+
+    /**
+     * Delete an object from its shard.
+     * @param {Realm.Object} object
+     */
+    delete(object) {}
+
+    /**
+     * Searches for a Realm object by its primary key.
+     * @param {Realm~ObjectType} type
+     * @param {number|string} key
+     * @returns {Realm.Object|undefined}
+     */
+    objectForPrimaryKey(type, key) {}
+
+    /**
+     * Returns all objects of the given type across all shards.
+     * @param {Realm~ObjectType} type
+     * @returns {Realm.Sharded.Results}
+     */
+    objects(type) {}
+
+    /**
+     * Compacts every shard.
+     * @returns {boolean} `true` if all shards were compacted.
+     */
+    compact() {}
+
+    /**
+     * Close all shards.
+     */
+    close() {}
+}
+
+/**
+ * Results spanning all shards of a {@link Realm.Sharded} Realm. Queries and aggregates are
+ * evaluated on each shard and merged. Sorted results are merged in sort order.
+ *
+ * Each shard sorts strings with the collation of the database, but the shards are merged by comparing
+ * strings by UTF-16 code unit. Results sorted by a string property are therefore only guaranteed to be in
+ * order across shards for strings which both orders agree on, such as ASCII strings of the same case.
+ * @memberof Realm.Sharded
+ * @since 2.16.0
+ */
+class Results {
+    /**
+     * The results of each shard.
+     * @type {Realm.Results[]}
+     * @readonly
+     */
+    get shards() {}
+
+    /**
+     * The number of objects across all shards.
+     * @type {number}
+     * @readonly
+     */
+    get length() {}
+
+    /**
+     * @returns {boolean}
+     */
+    isEmpty() {}
+
+    /**
+     * @param {string} query
+     * @param {...any} [arg]
+     * @returns {Realm.Sharded.Results}
+     * @see {@link Realm.Collection#filtered}
+     */
+    filtered(query, ...arg) {}
+
+    /**
+     * @param {string|Realm.Collection~SortDescriptor[]} descriptor
+     * @param {boolean} [reverse=false]
+     * @returns {Realm.Sharded.Results}
+     * @see {@link Realm.Collection#sorted}
+     */
+    sorted(descriptor, reverse) {}
+
+    /**
+     * @param {string} property
+     * @returns {number|Date|undefined}
+     */
+    min(property) {}
+
+    /**
+     * @param {string} property
+     * @returns {number|Date|undefined}
+     */
+    max(property) {}
+
+    /**
+     * @param {string} property
+     * @returns {number}
+     */
+    sum(property) {}
+
+    /**
+     * @param {string} property
+     * @returns {number|undefined}
+     */
+    avg(property) {}
+
+    /**
+     * @param {number} [start]
+     * @param {number} [end]
+     * @returns {Realm.Object[]}
+     */
+    slice(start, end) {}
+
+    /**
+     * @returns {Realm.Object[]}
+     */
+    toArray() {}
+}
@@ -737,9 +737,10 @@ class Subscription {
  *    passed as an argument.
  *
  * Worker automatically spawns child processes as needed to handle events in
- * parallel (up to the limit specified in the `options` parameter). Events for
- * each specific Realm will be processes in serial in the order in which the
- * events occurred, but may not all be processed in the same child.
+ * parallel (up to the limit specified in the `options` parameter). Each Realm
+ * is assigned to one child, which processes its events in serial in the order
+ * in which they occurred. When `maxQueueDepth` events are waiting for the
+ * children, no further changes are read from the server until they catch up.
  *
  * @example
  * // my-worker.js
@@ -771,10 +772,29 @@ class Worker {
      * Available properties are as follows:
      *
      * * `maxWorkers`: The maximum number of child processes to spawn. Defaults to `os.cpus().length`.
+     * * `maxQueueDepth`: The number of events which may wait for a child process before the delivery of
+     *   changes is paused. Defaults to no limit.
      * * `env`: An object containing environment variables to set for the child process.
      * * `execArgv`: Command-line arguments to pass to the `node` worker processes.
      */
     constructor(moduleName, options = {}) {}
+
+    /**
+     * Returns the number of changes waiting to be read from the server and the state of each child process.
+     * @returns {Object} An object with the following properties:
+     * - `pendingChanges`: the number of changes which have not been read from the server because
+     *   `maxQueueDepth` events are waiting for the children.
+     * - `children`: an object for each child with the following properties:
+     *   - `pid`: the process id of the child.
+     *   - `paths`: the number of Realms assigned to the child.
+     *   - `queued`: the number of events waiting for the child.
+     *   - `busy`: whether the child is processing an event.
+     *   - `processed`: the number of events the child has processed.
+     *   - `lastLatencyMs`, `maxLatencyMs`, `totalLatencyMs`: the time from an event being queued
+     *     until the child finished processing it, for the last event, the slowest one and all of them.
+     * @since 2.16.0
+     */
+    metrics() {}
 }
 
 /**
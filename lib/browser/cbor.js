@@ -0,0 +1,292 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2018 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+'use strict';
+
+// Minimal CBOR (RFC 7049) codec for the binary RPC protocol. ArrayBuffers and typed arrays are
+// written as byte strings, and byte strings are read back as ArrayBuffers. As with JSON,
+// object properties which are undefined are left out.
+
+const UNSIGNED_INTEGER = 0;
+const NEGATIVE_INTEGER = 1;
+const BYTE_STRING = 2;
+const TEXT_STRING = 3;
+const ARRAY = 4;
+const MAP = 5;
+const SIMPLE = 7;
+
+// Arrays and maps nested deeper than this are rejected rather than overflowing the stack.
+const MAX_DEPTH = 128;
+
+function encodeUTF8(string) {
+    if (typeof TextEncoder !== 'undefined') {
+        return new TextEncoder().encode(string);
+    }
+    const binary = unescape(encodeURIComponent(string));
+    const bytes = new Uint8Array(binary.length);
+    for (let i = 0; i < binary.length; i++) {
+        bytes[i] = binary.charCodeAt(i);
+    }
+    return bytes;
+}
+
+function decodeUTF8(bytes) {
+    if (typeof TextDecoder !== 'undefined') {
+        return new TextDecoder().decode(bytes);
+    }
+    let binary = '';
+    for (let i = 0; i < bytes.length; i += 0x8000) {
+        binary += String.fromCharCode.apply(null, bytes.subarray(i, i + 0x8000));
+    }
+    return decodeURIComponent(escape(binary));
+}
+
+function checkDepth(depth) {
+    if (depth >= MAX_DEPTH) {
+        throw new Error('CBOR input is nested too deeply');
+    }
+}
+
+class Writer {
+    constructor() {
+        this.bytes = new Uint8Array(256);
+        this.view = new DataView(this.bytes.buffer);
+        this.length = 0;
+    }
+
+    reserve(count) {
+        if (this.length + count <= this.bytes.length) {
+            return;
+        }
+        let capacity = this.bytes.length * 2;
+        while (capacity < this.length + count) {
+            capacity *= 2;
+        }
+        const bytes = new Uint8Array(capacity);
+        bytes.set(this.bytes.subarray(0, this.length));
+        this.bytes = bytes;
+        this.view = new DataView(bytes.buffer);
+    }
+
+    writeHead(major, value) {
+        this.reserve(9);
+        const initial = major << 5;
+        if (value < 24) {
+            this.bytes[this.length++] = initial | value;
+        } else if (value <= 0xff) {
+            this.bytes[this.length++] = initial | 24;
+            this.bytes[this.length++] = value;
+        } else if (value <= 0xffff) {
+            this.bytes[this.length++] = initial | 25;
+            this.view.setUint16(this.length, value);
+            this.length += 2;
+        } else if (value <= 0xffffffff) {
+            this.bytes[this.length++] = initial | 26;
+            this.view.setUint32(this.length, value);
+            this.length += 4;
+        } else {
+            this.bytes[this.length++] = initial | 27;
+            this.view.setUint32(this.length, Math.floor(value / 0x100000000));
+            this.view.setUint32(this.length + 4, value % 0x100000000);
+            this.length += 8;
+        }
+    }
+
+    writeBytes(major, bytes) {
+        this.writeHead(major, bytes.length);
+        this.reserve(bytes.length);
+        this.bytes.set(bytes, this.length);
+        this.length += bytes.length;
+    }
+
+    writeValue(value) {
+        if (value === null || value === undefined) {
+            this.reserve(1);
+            this.bytes[this.length++] = 0xf6;
+        } else if (typeof value === 'boolean') {
+            this.reserve(1);
+            this.bytes[this.length++] = value ? 0xf5 : 0xf4;
+        } else if (typeof value === 'number') {
+            if (Number.isSafeInteger(value)) {
+                if (value >= 0) {
+                    this.writeHead(UNSIGNED_INTEGER, value);
+                } else {
+                    this.writeHead(NEGATIVE_INTEGER, -1 - value);
+                }
+            } else {
+                this.reserve(9);
+                this.bytes[this.length++] = 0xfb;
+                this.view.setFloat64(this.length, value);
+                this.length += 8;
+            }
+        } else if (typeof value === 'string') {
+            this.writeBytes(TEXT_STRING, encodeUTF8(value));
+        } else if (value instanceof ArrayBuffer) {
+            this.writeBytes(BYTE_STRING, new Uint8Array(value));
+        } else if (ArrayBuffer.isView(value)) {
+            this.writeBytes(BYTE_STRING, new Uint8Array(value.buffer, value.byteOffset, value.byteLength));
+        } else if (Array.isArray(value)) {
+            this.writeHead(ARRAY, value.length);
+            value.forEach((item) => this.writeValue(item));
+        } else {
+            const keys = Object.keys(value).filter((key) => value[key] !== undefined);
+            this.writeHead(MAP, keys.length);
+            keys.forEach((key) => {
+                this.writeBytes(TEXT_STRING, encodeUTF8(key));
+                this.writeValue(value[key]);
+            });
+        }
+    }
+}
+
+class Reader {
+    constructor(bytes) {
+        this.bytes = bytes;
+        this.view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+        this.position = 0;
+    }
+
+    readArgument(info) {
+        let value;
+        switch (info) {
+            case 24:
+                value = this.view.getUint8(this.position);
+                this.position += 1;
+                return value;
+            case 25:
+                value = this.view.getUint16(this.position);
+                this.position += 2;
+                return value;
+            case 26:
+                value = this.view.getUint32(this.position);
+                this.position += 4;
+                return value;
+            case 27:
+                value = this.view.getUint32(this.position) * 0x100000000 + this.view.getUint32(this.position + 4);
+                this.position += 8;
+                return value;
+            default:
+                if (info < 24) {
+                    return info;
+                }
+                throw new Error('Indefinite length CBOR items are not supported');
+        }
+    }
+
+    readSimple(info) {
+        let value;
+        switch (info) {
+            case 20: return false;
+            case 21: return true;
+            case 22: return null;
+            case 23: return undefined;
+            case 25: {
+                const half = this.view.getUint16(this.position);
+                this.position += 2;
+                const exponent = (half >> 10) & 0x1f;
+                const mantissa = half & 0x3ff;
+                if (exponent === 0) {
+                    value = mantissa * Math.pow(2, -24);
+                } else if (exponent !== 31) {
+                    value = (mantissa + 1024) * Math.pow(2, exponent - 25);
+                } else {
+                    value = mantissa === 0 ? Infinity : NaN;
+                }
+                return half & 0x8000 ? -value : value;
+            }
+            case 26:
+                value = this.view.getFloat32(this.position);
+                this.position += 4;
+                return value;
+            case 27:
+                value = this.view.getFloat64(this.position);
+                this.position += 8;
+                return value;
+            default:
+                throw new Error('Unsupported CBOR simple value');
+        }
+    }
+
+    readValue(depth = 0) {
+        if (this.position >= this.bytes.length) {
+            throw new Error('Unexpected end of CBOR input');
+        }
+        const initial = this.bytes[this.position++];
+        const major = initial >> 5;
+        const info = initial & 0x1f;
+
+        if (major === SIMPLE) {
+            return this.readSimple(info);
+        }
+
+        const argument = this.readArgument(info);
+        switch (major) {
+            case UNSIGNED_INTEGER:
+                return argument;
+            case NEGATIVE_INTEGER:
+                return -1 - argument;
+            case BYTE_STRING: {
+                const start = this.bytes.byteOffset + this.position;
+                this.position += argument;
+                return this.bytes.buffer.slice(start, start + argument);
+            }
+            case TEXT_STRING: {
+                const string = decodeUTF8(this.bytes.subarray(this.position, this.position + argument));
+                this.position += argument;
+                return string;
+            }
+            case ARRAY: {
+                checkDepth(depth);
+                const array = new Array(argument);
+                for (let i = 0; i < argument; i++) {
+                    array[i] = this.readValue(depth + 1);
+                }
+                return array;
+            }
+            case MAP: {
+                checkDepth(depth);
+                const object = {};
+                for (let i = 0; i < argument; i++) {
+                    const key = this.readValue(depth + 1);
+                    object[key] = this.readValue(depth + 1);
+                }
+                return object;
+            }
+            default:
+                throw new Error('Unsupported CBOR type');
+        }
+    }
+}
+
+export function encode(value) {
+    const writer = new Writer();
+    writer.writeValue(value);
+    return writer.bytes.slice(0, writer.length);
+}
+
+export function decode(bytes) {
+    if (bytes instanceof ArrayBuffer) {
+        bytes = new Uint8Array(bytes);
+    }
+    const reader = new Reader(bytes);
+    const value = reader.readValue();
+    if (reader.position !== bytes.length) {
+        throw new Error('Unexpected data after CBOR item');
+    }
+    return value;
+}
@@ -20,9 +20,14 @@
 
 import { keys } from './constants';
 import { getterForProperty } from './util';
-import { getProperty, setProperty } from './rpc';
+import { deserialize, dropHeldObjects, getProperties, getProperty, holdObjects, isPrefetchCurrent, prefetched, setProperty } from './rpc';
 
 let mutationListeners = {};
+const prefetchedRows = Symbol('prefetchedRows');
+
+// Rows which were neither prefetched nor read before are fetched this many at a time in one batch
+// request, so iterating over a collection takes one round trip per window instead of one per row.
+const rowWindow = 50;
 
 export default class Collection {
     constructor() {
@@ -53,16 +58,51 @@ export function fireMutationListeners(realmId) {
     }
 }
 
-function isIndex(propertyName) {
+export function isIndex(propertyName) {
     return typeof propertyName === 'number' || (typeof propertyName === 'string' && /^-?\d+$/.test(propertyName));
 }
 
 const mutable = Symbol('mutable');
 
+function getRow(collection, index) {
+    let realmId = collection[keys.realm];
+    let rows = collection[prefetchedRows];
+    if (!rows || !isPrefetchCurrent(rows)) {
+        if (rows && rows.held) {
+            dropHeldObjects(rows, rows.held);
+        }
+        rows = collection[prefetchedRows] = prefetched([]);
+    }
+    if (index in rows.values) {
+        return deserialize(realmId, rows.values[index]);
+    }
+
+    let id = collection[keys.id];
+    let end = index >= 0 ? Math.min(index + rowWindow, collection.length) : index;
+    if (index >= end) {
+        // Let the server report the index as out of range.
+        return getProperty(realmId, id, String(index));
+    }
+
+    let names = [];
+    for (let i = index; i < end; i++) {
+        names.push(String(i));
+    }
+    let values = getProperties(realmId, id, names);
+    values.forEach((value, i) => rows.values[index + i] = value);
+
+    // The cached rows hold their objects until they are replaced after the next write or notification,
+    // or the collection is collected.
+    let ids = values.filter((value) => value.id).map((value) => value.id);
+    holdObjects(rows, ids);
+    (rows.held || (rows.held = [])).push(...ids);
+    return deserialize(realmId, values[0]);
+}
+
 const traps = {
     get(collection, property, receiver) {
         if (isIndex(property)) {
-            return getProperty(collection[keys.realm], collection[keys.id], property);
+            return getRow(collection, +property);
         }
 
         return Reflect.get(collection, property, collection);
@@ -132,6 +172,13 @@ export function createCollection(prototype, realmId, info, _mutable) {
     collection[keys.id] = info.id;
     collection[keys.type] = info.type;
     collection[mutable] = _mutable;
+    if (info.rows) {
+        collection[keys.prefetched] = prefetched({ length: { value: info.size } });
+        collection[prefetchedRows] = prefetched(info.rows);
+    }
 
-    return new Proxy(collection, traps);
+    // The collection also holds the objects in its prefetched rows.
+    let proxy = new Proxy(collection, traps);
+    holdObjects(proxy, [info.id].concat((info.rows || []).filter((row) => row.id).map((row) => row.id)));
+    return proxy;
 }
@@ -24,6 +24,7 @@ export const propTypes = {};
 
 [
     'id',
+    'prefetched',
     'realm',
     'type',
 ].forEach(function(name) {
@@ -39,6 +40,7 @@ export const propTypes = {};
     'OBJECT',
     'REALM',
     'RESULTS',
+    'RESULTSWINDOW',
     'USER',
     'SESSION',
     'SUBSCRIPTION',
@@ -22,7 +22,7 @@ import { NativeModules } from 'react-native';
 import { keys, objectTypes } from './constants';
 import Collection, * as collections from './collections';
 import List, { createList } from './lists';
-import Results, { createResults } from './results';
+import Results, { createResults, createResultsWindow } from './results';
 import RealmObject, * as objects from './objects';
 import User, { createUser } from './user';
 import Session, { createSession } from './session';
@@ -35,6 +35,7 @@ const {debugHosts, debugPort} = NativeModules.Realm;
 
 rpc.registerTypeConverter(objectTypes.LIST, createList);
 rpc.registerTypeConverter(objectTypes.RESULTS, createResults);
+rpc.registerTypeConverter(objectTypes.RESULTSWINDOW, createResultsWindow);
 rpc.registerTypeConverter(objectTypes.OBJECT, objects.createObject);
 rpc.registerTypeConverter(objectTypes.REALM, createRealm);
 rpc.registerTypeConverter(objectTypes.USER, createUser);
@@ -66,6 +67,8 @@ function setupRealm(realm, realmId) {
     ].forEach((name) => {
         Object.defineProperty(realm, name, {get: util.getterForProperty(name)});
     });
+
+    rpc.watchRealm(realmId);
 }
 
 function getObjectType(realm, type) {
@@ -122,16 +125,31 @@ export default class Realm {
         let method = util.createMethod(objectTypes.REALM, 'objectForPrimaryKey');
         return method.apply(this, [getObjectType(this, type), ...args]);
     }
+
+    removeAllListeners(...args) {
+        let method = util.createMethod(objectTypes.REALM, 'removeAllListeners');
+        method.apply(this, args);
+        rpc.watchRealm(this[keys.realm], true);
+    }
+
+    // Background file operations report their progress and completion from another thread, which the
+    // RPC server has no way to pass on to this client.
+    _writeCopyToAsync() {
+        throw new Error('Realm.prototype.writeCopyToAsync() is not supported when debugging in Chrome.');
+    }
 }
 
 // Non-mutating methods:
 util.createMethods(Realm.prototype, objectTypes.REALM, [
     'addListener',
     'removeListener',
-    'removeAllListeners',
+    'addBatchListener',
+    'removeBatchListener',
     'close',
     '_waitForDownload',
     '_objectForObjectId',
+    'createThreadSafeReference',
+    'resolveThreadSafeReference',
 ]);
 
 // Mutating methods:
@@ -182,11 +200,46 @@ Object.defineProperties(Realm, {
             return rpc.callMethod(undefined, Realm[keys.id], 'deleteFile', Array.from(arguments));
         }
     },
+    setNotificationBudget: {
+        value: function(_budgetMs) {
+            return rpc.callMethod(undefined, Realm[keys.id], 'setNotificationBudget', Array.from(arguments));
+        }
+    },
+    notificationMetrics: {
+        value: function() {
+            return rpc.callMethod(undefined, Realm[keys.id], 'notificationMetrics', []);
+        }
+    },
+    releaseThreadSafeReference: {
+        value: function(_reference) {
+            return rpc.callMethod(undefined, Realm[keys.id], 'releaseThreadSafeReference', Array.from(arguments));
+        }
+    },
+    _compactAsync: {
+        value: function() {
+            throw new Error('Realm.compactAsync() is not supported when debugging in Chrome.');
+        }
+    },
+    _cancelFileOperation: {
+        value: function() {
+            return false;
+        }
+    },
     copyBundledRealmFiles: {
         value: function() {
             return rpc.callMethod(undefined, Realm[keys.id], 'copyBundledRealmFiles', []);
         }
     },
+    _setDebugPrefetch: {
+        value: function(options) {
+            rpc.setPrefetch(options);
+        }
+    },
+    _debugHeldObjectCount: {
+        value: function() {
+            return rpc.heldObjectCount();
+        }
+    },
     clearTestState: {
         value: function() {
             collections.clearMutationListeners();
@@ -36,6 +36,7 @@ createMethods(List.prototype, objectTypes.LIST, [
     'max',
     'sum',
     'avg',
+    'count',
     'addListener',
     'removeListener',
     'removeAllListeners',
@@ -20,6 +20,7 @@
 
 import { keys, objectTypes } from './constants';
 import { getterForProperty, setterForProperty, createMethods } from './util';
+import { holdObjects, prefetched } from './rpc';
 
 let registeredConstructors = {};
 let registeredRealmPaths = {};
@@ -35,6 +36,9 @@ createMethods(RealmObject.prototype, objectTypes.OBJECT, [
     'linkingObjectsCount',
     '_objectId',
     '_isSameObject',
+    'addListener',
+    'removeListener',
+    'removeAllListeners',
 ]);
 
 export function clearRegisteredConstructors() {
@@ -51,6 +55,10 @@ export function createObject(realmId, info) {
     object[keys.realm] = realmId;
     object[keys.id] = info.id;
     object[keys.type] = info.type;
+    if (info.values) {
+        object[keys.prefetched] = prefetched(info.values);
+    }
+    holdObjects(object, [info.id]);
 
     schema.properties.forEach((name) => {
         Object.defineProperty(object, name, {
@@ -18,13 +18,24 @@
 
 'use strict';
 
-import Collection, { createCollection } from './collections';
-import { objectTypes } from './constants';
-import { createMethods } from './util';
+import Collection, { createCollection, isIndex } from './collections';
+import { keys, objectTypes } from './constants';
+import { getProperty, holdObjects } from './rpc';
+import { createMethods, getterForProperty } from './util';
 
 export default class Results extends Collection {
 }
 
+export class ResultsWindow {
+    constructor() {
+        throw new TypeError('Illegal constructor');
+    }
+}
+
+Object.defineProperty(Results, 'Window', {
+    value: ResultsWindow,
+});
+
 // Non-mutating methods:
 createMethods(Results.prototype, objectTypes.RESULTS, [
     'filtered',
@@ -37,6 +48,8 @@ createMethods(Results.prototype, objectTypes.RESULTS, [
     'max',
     'sum',
     'avg',
+    'count',
+    'window',
     'addListener',
     'removeListener',
     'removeAllListeners',
@@ -50,3 +63,40 @@ createMethods(Results.prototype, objectTypes.RESULTS, [
 export function createResults(realmId, info) {
     return createCollection(Results.prototype, realmId, info);
 }
+
+Object.defineProperties(ResultsWindow.prototype, {
+    length: { get: getterForProperty('length') },
+    start: { get: getterForProperty('start') },
+    count: { get: getterForProperty('count') },
+});
+
+createMethods(ResultsWindow.prototype, objectTypes.RESULTSWINDOW, [
+    'move',
+    'addListener',
+    'removeListener',
+    'removeAllListeners',
+]);
+
+// The rows of a window are not cached, since moving the window changes them.
+const windowTraps = {
+    get(target, property) {
+        if (isIndex(property)) {
+            return getProperty(target[keys.realm], target[keys.id], String(property));
+        }
+        return Reflect.get(target, property, target);
+    },
+    has(target, property) {
+        return isIndex(property) ? +property < target.length : Reflect.has(target, property);
+    },
+};
+
+export function createResultsWindow(realmId, info) {
+    let target = Object.create(ResultsWindow.prototype);
+    target[keys.realm] = realmId;
+    target[keys.id] = info.id;
+    target[keys.type] = objectTypes.RESULTSWINDOW;
+
+    let proxy = new Proxy(target, windowTraps);
+    holdObjects(proxy, [info.id]);
+    return proxy;
+}
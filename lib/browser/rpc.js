@@ -19,6 +19,7 @@
 'use strict';
 
 import * as base64 from './base64';
+import * as cbor from './cbor';
 import { keys, objectTypes } from './constants';
 
 const { id: idKey, realm: _realmKey } = keys;
@@ -33,6 +34,22 @@ let XMLHttpRequest = global.originalXMLHttpRequest || global.XMLHttpRequest;
 let sessionHost;
 let sessionId;
 
+// Set when the server agreed to use CBOR instead of JSON for the requests following create_session.
+let binaryProtocol = false;
+
+// Prefetched values are only used until something may have changed them: a write from this client,
+// or a callback from the server, which is how change notifications arrive. Commits from other threads
+// and sync only become visible when the Realm on the server refreshes and sends its 'change'
+// notification, so every Realm has a listener for it (see watchRealm()).
+let prefetchGeneration = 0;
+const watchedRealms = new Set();
+
+// Objects are released on the server once no wrapper refers to them any more. Wrappers hold the ids
+// they use through holdObjects(), and released ids are sent in batches along with the next request.
+const heldObjects = new Map();
+let releasedObjects = [];
+const objectRegistry = typeof FinalizationRegistry != 'undefined' ? new FinalizationRegistry(releaseObjects) : null;
+
 // Check if XMLHttpRequest has been overridden, and get the native one if that's the case.
 if (XMLHttpRequest.__proto__ != global.XMLHttpRequestEventTarget) {
     let fakeXMLHttpRequest = XMLHttpRequest;
@@ -41,7 +58,7 @@ if (XMLHttpRequest.__proto__ != global.XMLHttpRequestEventTarget) {
     global.XMLHttpRequest = fakeXMLHttpRequest;
 }
 
-registerTypeConverter(objectTypes.DATA, (_, { value }) => base64.decode(value));
+registerTypeConverter(objectTypes.DATA, (_, { value }) => value instanceof ArrayBuffer ? value : base64.decode(value));
 registerTypeConverter(objectTypes.DATE, (_, { value }) => new Date(value));
 registerTypeConverter(objectTypes.DICT, deserializeDict);
 registerTypeConverter(objectTypes.FUNCTION, deserializeFunction);
@@ -52,7 +69,8 @@ export function registerTypeConverter(type, handler) {
 
 export function createSession(refreshAccessToken, host) {
     refreshAccessToken[persistentCallback] = true;
-    sessionId = sendRequest('create_session', { refreshAccessToken: serialize(undefined, refreshAccessToken) }, host);
+    binaryProtocol = false;
+    sessionId = sendRequest('create_session', { refreshAccessToken: serialize(undefined, refreshAccessToken), protocols: ['cbor'] }, host);
     sessionHost = host;
     return sessionId;
 }
@@ -99,9 +117,103 @@ export function getProperty(realmId, id, name) {
 
 export function setProperty(realmId, id, name, value) {
     value = serialize(realmId, value);
+    invalidatePrefetched();
     sendRequest('set_property', { realmId, id, name, value });
 }
 
+// Runs a list of operations in a single request. Each operation is an object with a `command` of
+// 'call_method', 'get_property', 'set_property' or 'dispose_object' and the same fields as the
+// single requests. Returns the serialized results of all operations in order.
+function batch(realmId, operations) {
+    operations = operations.map((operation) => {
+        let { command, id, name } = operation;
+        let serialized = { command, id, name };
+
+        if (command == 'call_method') {
+            serialized.arguments = (operation.arguments || []).map((arg) => serialize(realmId, arg));
+        }
+        else if (command == 'set_property') {
+            serialized.value = serialize(realmId, operation.value);
+        }
+
+        return serialized;
+    });
+
+    return sendRequest('batch', { realmId, operations });
+}
+
+// Reads several properties in one round trip. The values are returned serialized, so that they can be
+// cached like prefetched values and only deserialized when they are used.
+export function getProperties(realmId, id, names) {
+    return batch(realmId, names.map((name) => ({ command: 'get_property', id, name })));
+}
+
+// Makes the server inline the primitive property values of objects (`properties`) and the first
+// `rows` rows of lists and results in the values it returns.
+export function setPrefetch({ properties = false, rows = 0 } = {}) {
+    sendRequest('set_prefetch', { properties: !!properties, rows: Math.max(rows | 0, 0) });
+    invalidatePrefetched();
+}
+
+export function prefetched(values) {
+    return { generation: prefetchGeneration, values };
+}
+
+export function isPrefetchCurrent(prefetched) {
+    return prefetched.generation === prefetchGeneration;
+}
+
+export function invalidatePrefetched() {
+    prefetchGeneration++;
+}
+
+// Receiving the callback already invalidates the prefetched values.
+function onRealmChange() {}
+
+// `force` adds the listener again after removeAllListeners() removed it.
+export function watchRealm(realmId, force) {
+    if (force || !watchedRealms.has(realmId)) {
+        watchedRealms.add(realmId);
+        callMethod(realmId, realmId, 'addListener', ['change', onRealmChange]);
+    }
+}
+
+export function holdObjects(holder, ids) {
+    if (!objectRegistry || ids.length == 0) {
+        return;
+    }
+
+    ids.forEach((id) => heldObjects.set(id, (heldObjects.get(id) || 0) + 1));
+    objectRegistry.register(holder, ids, holder);
+}
+
+// Releases the ids held for `holder` before it is collected. `ids` must be all the ids it was given.
+export function dropHeldObjects(holder, ids) {
+    if (objectRegistry && objectRegistry.unregister(holder)) {
+        releaseObjects(ids);
+    }
+}
+
+// The number of references the wrappers in this client hold to objects on the server.
+export function heldObjectCount() {
+    let count = 0;
+    heldObjects.forEach((n) => count += n);
+    return count;
+}
+
+function releaseObjects(ids) {
+    ids.forEach((id) => {
+        let count = heldObjects.get(id);
+        if (count > 1) {
+            heldObjects.set(id, count - 1);
+        }
+        else if (count == 1) {
+            heldObjects.delete(id);
+            releasedObjects.push(id);
+        }
+    });
+}
+
 export function getAllUsers() {
     let result = sendRequest('get_all_users');
     return deserialize(undefined, result);
@@ -109,6 +221,12 @@ export function getAllUsers() {
 
 export function clearTestState() {
     sendRequest('clear_test_state');
+    invalidatePrefetched();
+    watchedRealms.clear();
+
+    // The server has released all objects.
+    heldObjects.clear();
+    releasedObjects = [];
 
     // Clear all registered callbacks that are specific to this session.
     registeredCallbacks = registeredCallbacks.filter(cb => Reflect.has(cb, persistentCallback));
@@ -145,7 +263,7 @@ function serialize(realmId, value) {
     }
 
     if (value instanceof ArrayBuffer || ArrayBuffer.isView(value)) {
-        return { type: objectTypes.DATA, value: base64.encode(value) };
+        return { type: objectTypes.DATA, value: binaryProtocol ? value : base64.encode(value) };
     }
 
     let keys = Object.keys(value);
@@ -183,7 +301,51 @@ function deserializeFunction(realmId, info) {
     return registeredCallbacks[info.value];
 }
 
+// Sends a CBOR encoded request and decodes the response. No Content-Type header is set so the
+// request stays a simple CORS request.
+function makeBinaryRequest(url, data) {
+    let body = cbor.encode(data);
+    let statusCode;
+    let responseBytes;
+
+    if (global.__debug__) {
+        let request = global.__debug__.require('sync-request');
+        let response = request('POST', url, { body: Buffer.from(body.buffer, body.byteOffset, body.byteLength) });
+
+        statusCode = response.statusCode;
+        responseBytes = new Uint8Array(response.body);
+    } else {
+        let request = new XMLHttpRequest();
+
+        // Synchronous requests can't use responseType, so read the bytes through a binary string.
+        request.open('POST', url, false);
+        request.overrideMimeType('text/plain; charset=x-user-defined');
+        request.send(body);
+
+        statusCode = request.status;
+        let responseText = request.responseText;
+        if (statusCode != 200) {
+            throw new Error(responseText);
+        }
+
+        responseBytes = new Uint8Array(responseText.length);
+        for (let i = 0; i < responseText.length; i++) {
+            responseBytes[i] = responseText.charCodeAt(i) & 0xff;
+        }
+    }
+
+    if (statusCode != 200) {
+        throw new Error(String.fromCharCode.apply(null, responseBytes));
+    }
+
+    return cbor.decode(responseBytes);
+}
+
 function makeRequest(url, data) {
+    if (binaryProtocol) {
+        return makeBinaryRequest(url, data);
+    }
+
     let statusCode;
     let responseText;
 
@@ -245,6 +407,11 @@ function sendRequest(command, data, host = sessionHost) {
 
         data = Object.assign({}, data, sessionId ? { sessionId } : null);
 
+        if (releasedObjects.length && !/^callback/.test(command) && command != 'create_session') {
+            data.releasedObjects = releasedObjects;
+            releasedObjects = [];
+        }
+
         let url = 'http://' + host + '/' + command;
         let response = makeRequest(url, data);
 
@@ -270,8 +437,13 @@ function sendRequest(command, data, host = sessionHost) {
 
             throw new Error(error || `Invalid response for "${command}"`);
         }
+        if (command == 'create_session') {
+            binaryProtocol = response.protocol == 'cbor';
+        }
         let callback = response.callback;
         if (callback != null) {
+            invalidatePrefetched();
+
             let result;
             let error;
             try {
@@ -46,6 +46,10 @@ export function createMethod(type, name, mutates) {
             throw new TypeError(name + ' method was called on an object of the wrong type!');
         }
 
+        if (mutates) {
+            rpc.invalidatePrefetched();
+        }
+
         try {
             return rpc.callMethod(realmId, id, name, Array.from(arguments));
         } finally {
@@ -58,6 +62,10 @@ export function createMethod(type, name, mutates) {
 
 export function getterForProperty(name) {
     return function() {
+        let prefetched = this[keys.prefetched];
+        if (prefetched && rpc.isPrefetchCurrent(prefetched) && name in prefetched.values) {
+            return rpc.deserialize(this[keys.realm], prefetched.values[name]);
+        }
         return rpc.getProperty(this[keys.realm], this[keys.id], name);
     };
 }
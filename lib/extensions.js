@@ -52,6 +52,27 @@ function waitForDownloadConfig(config) {
     return config;
 }
 
+// Run a native background file operation and expose it as a Promise which can be cancelled.
+// `start` receives the progress interval, progress callback and completion callback, and
+// returns the id of the scheduled operation.
+function fileOperation(realmConstructor, options, start) {
+    options = options || {};
+    let operationId;
+    let promise = new Promise((resolve, reject) => {
+        operationId = start(options.progressInterval, options.onProgress || null, (error, result) => {
+            if (error) {
+                reject(new Error(error.message));
+            }
+            else {
+                resolve(result);
+            }
+        });
+    });
+
+    promise.cancel = () => realmConstructor._cancelFileOperation(operationId);
+    return promise;
+}
+
 module.exports = function(realmConstructor) {
     // Add the specified Array methods to the Collection prototype.
     Object.defineProperties(realmConstructor.Collection.prototype, require('./collection-methods'));
@@ -130,6 +151,14 @@ module.exports = function(realmConstructor) {
             });
         },
 
+        compactAsync(config, options) {
+            if (config === undefined) { config = {}; }
+            if (typeof config == 'string') { config = {path: config}; }
+
+            return fileOperation(realmConstructor, options, (interval, onProgress, callback) =>
+                realmConstructor._compactAsync(config, interval, onProgress, callback));
+        },
+
         createTemplateObject(objectSchema) {
             let obj = {};
             for (let key in objectSchema.properties) {
@@ -172,6 +201,19 @@ module.exports = function(realmConstructor) {
         }
     }));
 
+    Object.defineProperty(realmConstructor, 'Sharded', {
+        value: require('./sharded')(realmConstructor),
+        configurable: true,
+    });
+
+    // Add background file operations
+    Object.defineProperties(realmConstructor.prototype, getOwnPropertyDescriptors({
+        writeCopyToAsync(path, encryptionKey, options) {
+            return fileOperation(realmConstructor, options, (interval, onProgress, callback) =>
+                this._writeCopyToAsync(path, encryptionKey || null, interval, onProgress, callback));
+        },
+    }));
+
     // Add sync methods
     if (realmConstructor.Sync) {
         let userMethods = require('./user-methods');
@@ -44,6 +44,15 @@ declare namespace Realm {
         [keys: string]: PropertyType | ObjectSchemaProperty;
     }
 
+    /**
+     * ThreadSafeReference
+     * @see { @link https://realm.io/docs/javascript/latest/api/Realm.html#createThreadSafeReference }
+     */
+    interface ThreadSafeReference<T> {
+        readonly type: 'object' | 'results' | 'list';
+        readonly path: string;
+    }
+
     /**
      * ObjectSchema
      * @see { @link https://realm.io/docs/javascript/latest/api/Realm.html#~ObjectSchema }
@@ -124,8 +133,21 @@ declare namespace Realm {
          * @returns number
          */
         linkingObjectsCount(): number;
+
+        addListener(callback: ObjectChangeCallback, options?: { keyPaths?: string[], priority?: number, weak?: boolean }): void;
+        removeListener(callback: ObjectChangeCallback): void;
+        removeAllListeners(): void;
+    }
+
+    interface ObjectChangeSet {
+        deleted: boolean;
+        changedProperties: string[];
     }
 
+    type ObjectChangeCallback = (object: Object, changes: ObjectChangeSet) => void;
+
+    type BatchChange = { object: Collection<any>, changes: CollectionChangeSet } | { object: Object, changes: ObjectChangeSet };
+
     const Object: {
         readonly prototype: Object;
     }
@@ -146,6 +168,35 @@ declare namespace Realm {
 
     type CollectionChangeCallback<T> = (collection: Collection<T>, change: CollectionChangeSet) => void;
 
+    interface CompactCollectionChangeSet {
+        insertions: Uint32Array;
+        deletions: Uint32Array;
+        modifications: Uint32Array;
+        newModifications: Uint32Array;
+        oldModifications: Uint32Array;
+    }
+
+    interface CollectionListenerOptions {
+        indexFormat?: 'array' | 'uint32' | 'ranges';
+        throttleMs?: number;
+        debounceMs?: number;
+        priority?: number;
+        weak?: boolean;
+    }
+
+    interface NotificationMetrics {
+        ticks: number;
+        delivered: number;
+        deferred: number;
+        lastTickMs: number;
+        maxTickMs: number;
+        totalTickMs: number;
+    }
+
+    interface AggregateOptions {
+        parallel?: boolean;
+    }
+
     /**
      * Collection
      * @see { @link https://realm.io/docs/javascript/latest/api/Realm.Collection.html }
@@ -164,10 +215,11 @@ declare namespace Realm {
          */
         isEmpty(): boolean;
 
-        min(property?: string): number | Date | null;
-        max(property?: string): number | Date | null;
-        sum(property?: string): number | null;
-        avg(property?: string): number;
+        min(property?: string, options?: AggregateOptions): number | Date | null;
+        max(property?: string, options?: AggregateOptions): number | Date | null;
+        sum(property?: string, options?: AggregateOptions): number | null;
+        avg(property?: string, options?: AggregateOptions): number;
+        count(options?: AggregateOptions): number;
 
         /**
          * @param  {string} query
@@ -194,7 +246,8 @@ declare namespace Realm {
          * @param  {(collection:any,changes:any)=>void} callback
          * @returns void
          */
-        addListener(callback: CollectionChangeCallback<T>): void;
+        addListener(callback: CollectionChangeCallback<T>, options?: CollectionListenerOptions & { indexFormat?: 'array' }): void;
+        addListener(callback: (collection: Collection<T>, change: CompactCollectionChangeSet) => void, options: CollectionListenerOptions): void;
 
         /**
          * @returns void
@@ -259,11 +312,83 @@ declare namespace Realm {
          * @returns void
          */
         update(property: string, value: any): void;
+
+        /**
+         * Create a live view of `count` objects starting at index `start`.
+         * @param  {number} start
+         * @param  {number} count
+         * @returns Results.Window<T>
+         */
+        window(start: number, count: number): Results.Window<T>;
     }
 
     const Results: {
         readonly prototype: Results<any>;
+        readonly Window: {
+            readonly prototype: Results.Window<any>;
+        };
     };
+
+    namespace Results {
+        type WindowChangeCallback<T> = (window: Window<T>, change: CollectionChangeSet) => void;
+
+        interface Window<T> {
+            readonly length: number;
+            readonly start: number;
+            readonly count: number;
+            readonly [index: number]: T;
+            move(start: number, count?: number): void;
+            addListener(callback: WindowChangeCallback<T>, options?: { indexFormat?: 'array', priority?: number, weak?: boolean }): void;
+            addListener(callback: (window: Window<T>, change: CompactCollectionChangeSet) => void, options: { indexFormat: 'uint32' | 'ranges', priority?: number, weak?: boolean }): void;
+            removeListener(callback: Function): void;
+            removeAllListeners(): void;
+        }
+    }
+
+    interface ShardedConfiguration extends Configuration {
+        shardCount: number;
+        shardKey: (objectType: string, properties: any) => any;
+    }
+
+    namespace Sharded {
+        /**
+         * Sharded Results
+         * @see { @link https://realm.io/docs/javascript/latest/api/Realm.Sharded.Results.html }
+         */
+        interface Results<T> {
+            readonly shards: Realm.Results<T>[];
+            readonly length: number;
+            isEmpty(): boolean;
+            filtered(query: string, ...arg: any[]): Results<T>;
+            sorted(descriptor: string | SortDescriptor[], reverse?: boolean): Results<T>;
+            min(property: string): number | Date | undefined;
+            max(property: string): number | Date | undefined;
+            sum(property: string): number;
+            avg(property: string): number | undefined;
+            slice(start?: number, end?: number): T[];
+            toArray(): T[];
+        }
+    }
+
+    /**
+     * Sharded
+     * @see { @link https://realm.io/docs/javascript/latest/api/Realm.Sharded.html }
+     */
+    class Sharded {
+        constructor(config: ShardedConfiguration);
+        readonly shards: Realm[];
+        readonly isInTransaction: boolean;
+        readonly isClosed: boolean;
+        readonly schema: ObjectSchema[];
+        shardIndex(objectType: string, properties: any): number;
+        write<T>(callback: () => T): T;
+        create<T>(type: string, properties: T, update?: boolean): T & Realm.Object;
+        delete(object: Realm.Object): void;
+        objectForPrimaryKey<T>(type: string, key: number | string): (T & Realm.Object) | undefined;
+        objects<T>(type: string): Sharded.Results<T & Realm.Object>;
+        compact(): boolean;
+        close(): void;
+    }
 }
 
 /**
@@ -599,6 +724,15 @@ declare namespace Realm.Permissions {
     }
 }
 
+interface FileOperationOptions {
+    onProgress?: (transferred: number, transferable: number) => void;
+    progressInterval?: number;
+}
+
+interface FileOperationPromise extends Promise<boolean> {
+    cancel(): boolean;
+}
+
 interface ProgressPromise extends Promise<Realm> {
     progress(callback: Realm.Sync.ProgressNotificationCallback): Promise<Realm>
 }
@@ -651,12 +785,32 @@ declare class Realm {
      */
     static createTemplateObject<T>(objectSchema: Realm.ObjectSchema): T;
 
+    /**
+     * Limit the time spent calling collection and object listeners in one turn of the event loop.
+     * @param {number} budgetMs
+     */
+    static setNotificationBudget(budgetMs: number): void;
+
+    /**
+     * Get statistics about the listener calls of the current thread.
+     * @returns NotificationMetrics
+     */
+    static notificationMetrics(): Realm.NotificationMetrics;
+
     /**
      * Delete the Realm file for the given configuration.
      * @param {Configuration} config
      */
     static deleteFile(config: Realm.Configuration): void;
 
+    /**
+     * Compact the Realm file for the given configuration on a background thread.
+     * @param {Configuration} config
+     * @param {FileOperationOptions} options?
+     * @returns FileOperationPromise
+     */
+    static compactAsync(config?: Realm.Configuration, options?: FileOperationOptions): FileOperationPromise;
+
     /**
      * @param  {Realm.Configuration} config?
      */
@@ -714,7 +868,7 @@ declare class Realm {
      * @param  {()=>void} callback
      * @returns void
      */
-    addListener(name: string, callback: (sender: Realm, event: 'change') => void): void;
+    addListener(name: string, callback: (sender: Realm, event: 'change') => void, options?: { throttleMs?: number, debounceMs?: number }): void;
     addListener(name: string, callback: (sender: Realm, event: 'schema', schema: Realm.ObjectSchema[]) => void): void;
 
     /**
@@ -731,6 +885,9 @@ declare class Realm {
      */
     removeAllListeners(name?: string): void;
 
+    addBatchListener(callback: (sender: Realm, changes: Realm.BatchChange[]) => void, objects: (Realm.Collection<any> | Realm.Object)[]): void;
+    removeBatchListener(callback: (sender: Realm, changes: Realm.BatchChange[]) => void): void;
+
     /**
      * @param  {()=>void} callback
      * @returns void
@@ -765,6 +922,35 @@ declare class Realm {
      */
     writeCopyTo(path: string, encryptionKey?: ArrayBuffer | ArrayBufferView): void;
 
+    /**
+     * Write a copy to destination path on a background thread
+     * @param path destination path
+     * @param encryptionKey encryption key to use
+     * @param options progress reporting options
+     * @returns FileOperationPromise
+     */
+    writeCopyToAsync(path: string, encryptionKey?: ArrayBuffer | ArrayBufferView | null, options?: FileOperationOptions): FileOperationPromise;
+
+    /**
+     * Create a reference which can be resolved by a Realm on another thread
+     * @param object the object or collection to hand over
+     * @returns ThreadSafeReference
+     */
+    createThreadSafeReference<T>(object: T & (Realm.Object | Realm.Collection<any>)): Realm.ThreadSafeReference<T>;
+
+    /**
+     * Resolve a reference created by `createThreadSafeReference()`
+     * @param reference the reference to resolve
+     */
+    resolveThreadSafeReference<T>(reference: Realm.ThreadSafeReference<T>): T;
+
+    /**
+     * Release a reference created by `createThreadSafeReference()` without resolving it
+     * @param reference the reference to release
+     * @returns boolean
+     */
+    static releaseThreadSafeReference(reference: Realm.ThreadSafeReference<any>): boolean;
+
     privileges() : Realm.Permissions.Realm;
     privileges(objectType: string | Realm.ObjectSchema | Function) : Realm.Permissions.Class;
     privileges(obj: Realm.Object) : Realm.Permissions.Class;
@@ -27,6 +27,9 @@ function nodeRequire(module) {
 
 const Worker = nodeRequire('./worker');
 
+// Shared by all paths no listener matches, so that unwatched paths do not each cost an array.
+const noCallbacks = Object.freeze([]);
+
 class FunctionListener {
     constructor(regex, regexStr, event, fn) {
         this.regex = regex;
@@ -45,15 +48,17 @@ class FunctionListener {
         return this.regexStr === regex && this.event === event && this.fn === fn;
     }
 
+    // `handler` is the name of the method a change is delivered to, e.g. 'onchange'.
+    wants(handler) {
+        return handler === 'on' + this.event;
+    }
+
     onavailable(path, id) {
-        if (this.regex.test(path)) {
-            if (this.event === 'available' && !this.seen[id]) {
-                this.fn(path);
-                this.seen[id] = true;
-            }
-            return this.event === 'change';
+        if (this.event === 'available' && !this.seen[id]) {
+            this.fn(path);
+            this.seen[id] = true;
         }
-        return false;
+        return this.event === 'change';
     }
 
     invoke(changes, arg) {
@@ -78,10 +83,6 @@ class FunctionListener {
     }
 
     onchange(changes) {
-        if (this.event !== 'change' || !this.regex.test(changes.path)) {
-            changes.release();
-            return;
-        }
         if (changes.isEmpty) {
             changes.release();
             return;
@@ -91,24 +92,28 @@ class FunctionListener {
     }
 
     ondelete(changes) {
-        if (this.event !== 'delete' || !this.regex.test(changes.path)) {
-            changes.release();
-            return;
-        }
-
         this.invoke(changes, changes.path);
     }
 }
 
 class OutOfProcListener {
-    constructor(regex, regexStr, worker) {
+    constructor(regex, regexStr, worker, ondrain, pendingChanges) {
         this.regex = regex;
         this.regexStr = regexStr;
         this.worker = worker;
+        this.ondrain = ondrain;
         this.seen = {};
+        worker.on('drain', ondrain);
+        worker._pendingChanges = pendingChanges;
+    }
+
+    get isFull() {
+        return this.worker.isFull;
     }
 
     stop() {
+        this.worker.removeListener('drain', this.ondrain);
+        this.worker._pendingChanges = () => 0;
         return this.worker.stop();
     }
 
@@ -116,28 +121,23 @@ class OutOfProcListener {
         return this.regexStr === regex && this.worker === worker;
     }
 
+    wants(handler) {
+        return true;
+    }
+
     onavailable(path, id) {
-        if (this.regex.test(path)) {
-            if (!this.seen[id]) {
-                this.worker.onavailable(path);
-                this.seen[id] = true;
-            }
-            return true;
+        if (!this.seen[id]) {
+            this.worker.onavailable(path);
+            this.seen[id] = true;
         }
-        return false;
+        return true;
     }
 
     onchange(changes) {
-        if (!this.regex.test(changes.path)) {
-            return;
-        }
         this.worker.onchange(changes);
     }
 
     ondelete(changes) {
-        if (!this.regex.test(changes.path)) {
-            return;
-        }
         this.worker.ondelete(changes);
     }
 }
@@ -147,6 +147,12 @@ class Listener {
         this.notifier = Sync._createNotifier(server, user, (event, a1, a2) => this[event](a1, a2));
         this.initPromises = [];
         this.callbacks = [];
+        // The callbacks whose regex matches each path seen so far, so each regex is tested once per path
+        // rather than for every change.
+        this.matching = new Map();
+        // The changes the native notifier has announced but which have not been fetched yet, because a
+        // worker's queue was full.
+        this.pendingChanges = 0;
     }
 
     // callbacks for C++ functions
@@ -162,29 +168,14 @@ class Listener {
     }
 
     change() {
-        const changes = this.notifier.next();
-        if (!changes) {
-            return;
-        }
-
-        let refCount = 1;
-        changes.release = () => {
-            if (--refCount === 0) {
-                changes.close();
-            }
-        }
-
-        for (const callback of this.callbacks) {
-            ++refCount;
-            callback[changes.event](changes);
-        }
-        changes.release();
+        ++this.pendingChanges;
+        this._deliverChanges();
     }
 
     available(virtualPath, id) {
         let watch = false;
         id = id || virtualPath;
-        for (const callback of this.callbacks) {
+        for (const callback of this._matching(virtualPath)) {
             if (callback.onavailable(virtualPath, id)) {
                 watch = true;
             }
@@ -200,11 +191,13 @@ class Listener {
             this.callbacks.push(new FunctionListener(regex, regexStr, event, fn));
         }
         else if (event instanceof Worker) {
-            this.callbacks.push(new OutOfProcListener(regex, regexStr, event));
+            this.callbacks.push(new OutOfProcListener(regex, regexStr, event, () => this._deliverChanges(),
+                                                         () => this.pendingChanges));
         }
         else {
             throw new Error(`Invalid arguments: must supply either event name and callback function or a Worker, got (${event}, ${fn})`);
         }
+        this.matching.clear();
 
         const promise = new Promise((resolve, reject) => {
             this.initPromises.push([resolve, reject]);
@@ -219,6 +212,10 @@ class Listener {
             if (this.callbacks[i].matches(regex, event, callback)) {
                 const ret = this.callbacks[i].stop();
                 this.callbacks.splice(i, 1);
+                this.matching.clear();
+                if (this.callbacks.length > 0) {
+                    this._deliverChanges();
+                }
                 return ret;
             }
         }
@@ -228,6 +225,9 @@ class Listener {
     removeAll() {
         let ret = Promise.all(this.callbacks.map(c => c.stop()));
         this.callbacks = [];
+        this.matching.clear();
+        // Fetches and closes the changes held back for a full worker, before the notifier is closed.
+        this._deliverChanges();
         return ret;
     }
 
@@ -236,6 +236,63 @@ class Listener {
     }
 
     // helpers
+    _deliverChanges() {
+        if (this.delivering) {
+            return;
+        }
+        this.delivering = true;
+        try {
+            while (this.pendingChanges > 0 && !this.callbacks.some(c => c.isFull)) {
+                --this.pendingChanges;
+                this._deliverChange();
+            }
+        }
+        finally {
+            this.delivering = false;
+        }
+    }
+
+    _deliverChange() {
+        const changes = this.notifier.next();
+        if (!changes) {
+            return;
+        }
+
+        const callbacks = this._matching(changes.path).filter(c => c.wants(changes.event));
+        if (changes.event === 'ondelete') {
+            this.matching.delete(changes.path);
+        }
+        if (callbacks.length === 0) {
+            changes.close();
+            return;
+        }
+
+        let refCount = 1;
+        changes.release = () => {
+            if (--refCount === 0) {
+                changes.close();
+            }
+        }
+
+        for (const callback of callbacks) {
+            ++refCount;
+            callback[changes.event](changes);
+        }
+        changes.release();
+    }
+
+    _matching(path) {
+        let callbacks = this.matching.get(path);
+        if (!callbacks) {
+            callbacks = this.callbacks.filter(c => c.regex.test(path));
+            if (callbacks.length === 0) {
+                callbacks = noCallbacks;
+            }
+            this.matching.set(path, callbacks);
+        }
+        return callbacks;
+    }
+
     _notifyDownloadComplete() {
         if (!this.initComplete) {
             return;
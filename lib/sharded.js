@@ -0,0 +1,336 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2018 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+'use strict';
+
+// FNV-1a, used to map string shard keys onto shard indexes.
+function hashString(string) {
+    let hash = 0x811c9dc5;
+    for (let i = 0; i < string.length; i++) {
+        hash ^= string.charCodeAt(i);
+        hash = Math.imul(hash, 0x01000193);
+    }
+    return hash >>> 0;
+}
+
+function shardPath(path, index) {
+    const match = /^(.*?)(\.realm)?$/.exec(path);
+    return `${match[1]}.shard-${index}${match[2] || ''}`;
+}
+
+function normalizeDescriptors(descriptor, reverse) {
+    if (!Array.isArray(descriptor)) {
+        return [[descriptor, !!reverse]];
+    }
+    return descriptor.map((item) => Array.isArray(item) ? [item[0], !!item[1]] : [item, false]);
+}
+
+function valueAtKeyPath(object, keyPath) {
+    return keyPath.split('.').reduce((value, key) => value == null ? value : value[key], object);
+}
+
+// Orders null before everything else, as core does. Strings are compared by UTF-16 code unit, which is
+// not core's collation: mixed-case and non-ASCII strings may be ordered differently than within a shard.
+function compareValues(a, b) {
+    if (a == null || b == null) {
+        return a == null ? (b == null ? 0 : -1) : 1;
+    }
+    if (a instanceof Date) {
+        a = a.getTime();
+        b = b.getTime();
+    }
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+class ShardedResults {
+    constructor(results, descriptors) {
+        this._results = results;
+        this._descriptors = descriptors || [];
+    }
+
+    get shards() {
+        return this._results.slice();
+    }
+
+    get length() {
+        return this._results.reduce((length, results) => length + results.length, 0);
+    }
+
+    isEmpty() {
+        return this._results.every((results) => results.isEmpty());
+    }
+
+    filtered(query, ...args) {
+        return new ShardedResults(this._results.map((results) => results.filtered(query, ...args)), this._descriptors);
+    }
+
+    sorted(descriptor, reverse) {
+        const descriptors = normalizeDescriptors(descriptor, reverse);
+        return new ShardedResults(this._results.map((results) => results.sorted(descriptors)), descriptors);
+    }
+
+    min(property) {
+        return this._results.reduce((min, results) => {
+            const value = results.min(property);
+            return value === undefined || (min !== undefined && compareValues(min, value) <= 0) ? min : value;
+        }, undefined);
+    }
+
+    max(property) {
+        return this._results.reduce((max, results) => {
+            const value = results.max(property);
+            return value === undefined || (max !== undefined && compareValues(max, value) >= 0) ? max : value;
+        }, undefined);
+    }
+
+    sum(property) {
+        return this._results.reduce((sum, results) => sum + results.sum(property), 0);
+    }
+
+    avg(property) {
+        let sum = 0;
+        let count = 0;
+        this._results.forEach((results) => {
+            const nonNull = results.filtered(`${property} != null`).length;
+            if (nonNull > 0) {
+                sum += results.avg(property) * nonNull;
+                count += nonNull;
+            }
+        });
+        return count > 0 ? sum / count : undefined;
+    }
+
+    // Returns the objects in [start, end). Unsorted results are concatenated in shard order,
+    // sorted results are merged so that the sort order holds across shards.
+    slice(start, end) {
+        const length = this.length;
+        start = start === undefined ? 0 : (start < 0 ? Math.max(length + start, 0) : Math.min(start, length));
+        end = end === undefined ? length : (end < 0 ? Math.max(length + end, 0) : Math.min(end, length));
+
+        const objects = [];
+        if (this._descriptors.length === 0) {
+            let offset = 0;
+            for (const results of this._results) {
+                if (offset + results.length > start && offset < end) {
+                    objects.push(...results.slice(Math.max(start - offset, 0), end - offset));
+                }
+                offset += results.length;
+            }
+            return objects;
+        }
+
+        const positions = this._results.map(() => 0);
+        for (let index = 0; index < end; index++) {
+            let next = -1;
+            for (let shard = 0; shard < this._results.length; shard++) {
+                if (positions[shard] < this._results[shard].length &&
+                    (next === -1 || this._compare(this._results[shard][positions[shard]], this._results[next][positions[next]]) < 0)) {
+                    next = shard;
+                }
+            }
+            if (index >= start) {
+                objects.push(this._results[next][positions[next]]);
+            }
+            positions[next]++;
+        }
+        return objects;
+    }
+
+    toArray() {
+        return this.slice();
+    }
+
+    forEach(callback, thisArg) {
+        this.toArray().forEach(callback, thisArg);
+    }
+
+    map(callback, thisArg) {
+        return this.toArray().map(callback, thisArg);
+    }
+
+    _compare(a, b) {
+        for (const [keyPath, reverse] of this._descriptors) {
+            const result = compareValues(valueAtKeyPath(a, keyPath), valueAtKeyPath(b, keyPath));
+            if (result !== 0) {
+                return reverse ? -result : result;
+            }
+        }
+        return 0;
+    }
+}
+
+if (typeof Symbol !== 'undefined' && Symbol.iterator) {
+    ShardedResults.prototype[Symbol.iterator] = function() {
+        return this.toArray()[Symbol.iterator]();
+    };
+}
+
+module.exports = function(realmConstructor) {
+    class ShardedRealm {
+        constructor(config) {
+            config = Object.assign({}, config);
+            const shardCount = config.shardCount;
+            const shardKey = config.shardKey;
+            delete config.shardCount;
+            delete config.shardKey;
+
+            if (!Number.isInteger(shardCount) || shardCount < 1) {
+                throw new Error("'shardCount' must be a positive integer.");
+            }
+            if (typeof shardKey !== 'function') {
+                throw new Error("'shardKey' must be a function.");
+            }
+
+            const path = config.path || realmConstructor.defaultPath;
+            this._shardKey = shardKey;
+            this._realms = [];
+            this._writing = null;
+            try {
+                for (let i = 0; i < shardCount; i++) {
+                    this._realms.push(new realmConstructor(Object.assign({}, config, {path: shardPath(path, i)})));
+                }
+            } catch (e) {
+                this.close();
+                throw e;
+            }
+        }
+
+        get shards() {
+            return this._realms.slice();
+        }
+
+        get isInTransaction() {
+            return this._writing !== null;
+        }
+
+        get isClosed() {
+            return this._realms.every((realm) => realm.isClosed);
+        }
+
+        get schema() {
+            return this._realms[0].schema;
+        }
+
+        // Returns the index of the shard holding objects of `objectType` with the given properties,
+        // or -1 if the shard key cannot be derived from them.
+        shardIndex(objectType, properties) {
+            const key = this._shardKey(objectType, properties);
+            if (key === undefined || key === null) {
+                return -1;
+            }
+            if (typeof key === 'number' && !Number.isFinite(key)) {
+                throw new Error(`The shard key of the '${objectType}' object must be a finite number, got ${key}.`);
+            }
+            const hash = typeof key === 'number' ? Math.abs(Math.floor(key)) : hashString(String(key));
+            return hash % this._realms.length;
+        }
+
+        // Writes to each shard are only started when the callback first creates or deletes an object in
+        // it, so writers touching different shards do not block each other. Every shard is committed
+        // separately: changes spanning several shards are not atomic.
+        write(callback) {
+            if (this._writing) {
+                throw new Error('The Realm is already in a write transaction');
+            }
+            this._writing = new Set();
+            try {
+                const result = callback();
+                this._writing.forEach((realm) => realm.commitTransaction());
+                return result;
+            } catch (e) {
+                this._writing.forEach((realm) => {
+                    if (realm.isInTransaction) {
+                        realm.cancelTransaction();
+                    }
+                });
+                throw e;
+            } finally {
+                this._writing = null;
+            }
+        }
+
+        create(objectType, properties, update) {
+            const index = this.shardIndex(objectType, properties);
+            if (index === -1) {
+                throw new Error(`Could not determine the shard of the '${objectType}' object.`);
+            }
+            return this._writableRealm(index).create(objectType, properties, update);
+        }
+
+        delete(object) {
+            this._writableRealm(this._shardIndexOf(object)).delete(object);
+        }
+
+        objectForPrimaryKey(objectType, key) {
+            const primaryKey = this._primaryKey(objectType);
+            const index = this.shardIndex(objectType, {[primaryKey]: key});
+            const realms = index === -1 ? this._realms : [this._realms[index]];
+            for (const realm of realms) {
+                const object = realm.objectForPrimaryKey(objectType, key);
+                if (object) {
+                    return object;
+                }
+            }
+            return undefined;
+        }
+
+        objects(objectType) {
+            return new ShardedResults(this._realms.map((realm) => realm.objects(objectType)));
+        }
+
+        compact() {
+            return this._realms.map((realm) => realm.compact()).every((compacted) => compacted);
+        }
+
+        close() {
+            this._realms.forEach((realm) => realm.close());
+        }
+
+        _writableRealm(index) {
+            if (!this._writing) {
+                throw new Error('Can only create or delete objects within a transaction.');
+            }
+            const realm = this._realms[index];
+            if (!this._writing.has(realm)) {
+                realm.beginTransaction();
+                this._writing.add(realm);
+            }
+            return realm;
+        }
+
+        _shardIndexOf(object) {
+            const objectType = object.objectSchema().name;
+            const index = this.shardIndex(objectType, object);
+            if (index === -1) {
+                throw new Error(`Could not determine the shard of the '${objectType}' object.`);
+            }
+            return index;
+        }
+
+        _primaryKey(objectType) {
+            const objectSchema = this.schema.find((schema) => schema.name === objectType);
+            if (!objectSchema || !objectSchema.primaryKey) {
+                throw new Error(`'${objectType}' does not have a primary key defined`);
+            }
+            return objectSchema.primaryKey;
+        }
+    }
+
+    ShardedRealm.Results = ShardedResults;
+    return ShardedRealm;
+};
@@ -26,56 +26,131 @@ function nodeRequire(module) {
 }
 
 const cp = nodeRequire('child_process');
+const EventEmitter = nodeRequire('events');
 const os = nodeRequire('os');
 
-class Worker {
+function elapsedMs(since) {
+    const [seconds, nanoseconds] = process.hrtime(since);
+    return seconds * 1e3 + nanoseconds / 1e6;
+}
+
+// Each Realm path is pinned to one child process, which handles all of its events in order. Messages wait
+// in the queue of their child until it has finished with the previous one. Once `maxQueueDepth` messages
+// are waiting in total, `isFull` is true until a child takes the next message, when 'drain' is emitted.
+class Worker extends EventEmitter {
     constructor(modulePath, options={}) {
+        super();
         this.modulePath = modulePath;
         this.maxWorkers = options.maxWorkers || os.cpus().length;
+        this.maxQueueDepth = options.maxQueueDepth || Infinity;
         this.env = options.env || {};
-        this.execArgv = options.execArgv || {};
+        this.execArgv = options.execArgv || [];
 
         this._workers = [];
-        this._waiting = [];
-        this._workQueue = [];
-        this._changeObjects = {};
+        this._paths = new Map();
+        this._queued = 0;
+        this._full = false;
+        // Replaced by the global listener the Worker is added to, which holds back changes while it is full.
+        this._pendingChanges = () => 0;
 
         this._startWorker();
     }
 
+    get isFull() {
+        return this._queued >= this.maxQueueDepth;
+    }
+
     onavailable(path) {
-        this._push({message: 'available', path});
+        this._push(path, {message: 'available', path});
     }
 
     ondelete(change) {
-        const serialized = change.serialize();
-        change.refCount = (change.refCount || 0) + 1;
-        this._changeObjects[serialized] = change;
-        this._push({message: 'delete', change: serialized});
+        this._push(change.path, {message: 'delete', change: change.serialize()}, change);
     }
 
     onchange(change) {
-        const serialized = change.serialize();
-        change.refCount = (change.refCount || 0) + 1;
-        this._changeObjects[serialized] = change;
-        this._push({message: 'change', change: serialized});
+        this._push(change.path, {message: 'change', change: change.serialize()}, change);
+    }
+
+    metrics() {
+        return {
+            pendingChanges: this._pendingChanges(),
+            children: this._workers.map(worker => ({
+                pid: worker.child.pid,
+                paths: worker.paths,
+                queued: worker.queue.length,
+                busy: worker.current !== null,
+                processed: worker.processed,
+                lastLatencyMs: worker.lastLatencyMs,
+                maxLatencyMs: worker.maxLatencyMs,
+                totalLatencyMs: worker.totalLatencyMs,
+            })),
+        };
     }
 
     stop() {
         this._stopping = true;
         return new Promise((r) => {
             this._shutdownComplete = r;
-            this._next();
+            if (this._workers.length === 0) {
+                r();
+                return;
+            }
+            for (const worker of this._workers) {
+                this._next(worker);
+            }
         });
     }
 
-    _push(message) {
+    _push(path, message, change) {
         if (this._stopping) {
+            if (change) {
+                change.release();
+            }
             return;
         }
 
-        this._workQueue.push(message);
-        this._next();
+        this._enqueue({path, message, change, queuedAt: process.hrtime()});
+        // Set after sending, so that 'drain' is only emitted once a child finishes a message.
+        if (this.isFull) {
+            this._full = true;
+        }
+    }
+
+    _enqueue(item) {
+        const worker = this._workerFor(item.path);
+        worker.queue.push(item);
+        ++this._queued;
+        this._next(worker);
+    }
+
+    // Pins a new path to an idle child if there is one, then to a new child while there are fewer than
+    // maxWorkers, and otherwise to the child with the least work waiting.
+    _workerFor(path) {
+        let worker = this._paths.get(path);
+        if (worker) {
+            return worker;
+        }
+
+        const running = this._workers.filter(w => !w.stopping);
+        worker = running.find(w => w.paths === 0);
+        if (!worker && running.length < this.maxWorkers) {
+            worker = this._startWorker();
+        }
+        if (!worker) {
+            const load = w => w.queue.length + (w.current ? 1 : 0);
+            worker = running.reduce((a, b) => load(b) < load(a) || (load(b) === load(a) && b.paths < a.paths) ? b : a);
+        }
+        ++worker.paths;
+        this._paths.set(path, worker);
+        return worker;
+    }
+
+    _unpin(worker, path) {
+        if (this._paths.get(path) === worker && !worker.queue.some(item => item.path === path)) {
+            this._paths.delete(path);
+            --worker.paths;
+        }
     }
 
     _startWorker() {
@@ -83,52 +158,91 @@ class Worker {
             env: this.env,
             execArgv: this.execArgv
         });
-        child.on('message', (m) => {
-            if (m.change) {
-                const changeObj = this._changeObjects[m.change];
-                delete this._changeObjects[m.change];
-                changeObj.release();
+        const worker = {
+            child,
+            queue: [],
+            current: null,
+            paths: 0,
+            processed: 0,
+            lastLatencyMs: 0,
+            maxLatencyMs: 0,
+            totalLatencyMs: 0,
+        };
+        child.on('message', () => {
+            const item = worker.current;
+            worker.current = null;
+            if (item) {
+                const latency = elapsedMs(item.queuedAt);
+                ++worker.processed;
+                worker.lastLatencyMs = latency;
+                worker.maxLatencyMs = Math.max(worker.maxLatencyMs, latency);
+                worker.totalLatencyMs += latency;
+                if (item.change) {
+                    item.change.release();
+                }
+                if (item.message.message === 'delete') {
+                    this._unpin(worker, item.path);
+                }
             }
-            this._waiting.push(child);
-            this._next();
+            this._next(worker);
         });
         child.on('exit', (code, signal) => {
             if (code !== 0) {
                 console.error(`Unexpected exit code from child: ${code} ${signal}`);
             }
-            this._workers = this._workers.filter(c => c !== child);
-            this._next();
-        });
-        child.send({message: 'load', module: this.modulePath});
-        this._workers.push(child);
-        this._waiting.push(child);
-    }
+            this._workers = this._workers.filter(w => w !== worker);
+            if (worker.current && worker.current.change) {
+                worker.current.change.release();
+            }
+            worker.current = null;
 
-    _next() {
-        if (this._stopping && this._workQueue.length === 0) {
-            for (const worker of this._workers) {
-                if (!worker.stopping) {
-                    worker.send({message: 'stop'});
-                    worker.stopping = true;
+            // Hand the paths of the child and the messages waiting for it over to the others.
+            for (const [path, w] of this._paths) {
+                if (w === worker) {
+                    this._paths.delete(path);
                 }
             }
-            if (this._workers.length === 0) {
+            const orphaned = worker.queue;
+            worker.queue = [];
+            this._queued -= orphaned.length;
+            for (const item of orphaned) {
+                this._enqueue(item);
+            }
+
+            if (this._stopping && this._workers.length === 0) {
                 this._shutdownComplete();
             }
+            this._checkDrain();
+        });
+        child.send({message: 'load', module: this.modulePath});
+        this._workers.push(worker);
+        return worker;
+    }
+
+    _next(worker) {
+        if (worker.current || worker.stopping) {
             return;
         }
-        if (this._workQueue.length === 0) {
-            return;
-        }
-        if (this._waiting.length === 0) {
-            if (this._workers.length < this.maxWorkers) {
-                this._startWorker();
+        if (worker.queue.length === 0) {
+            if (this._stopping) {
+                worker.child.send({message: 'stop'});
+                worker.stopping = true;
             }
             return;
         }
-        const worker = this._waiting.shift();
-        const message = this._workQueue.shift();
-        worker.send(message);
+
+        const item = worker.queue.shift();
+        --this._queued;
+        worker.current = item;
+        worker.child.send(item.message);
+        this._checkDrain();
+    }
+
+    _checkDrain() {
+        if (this._full && !this.isFull) {
+            this._full = false;
+            this.emit('drain');
+        }
     }
 }
 
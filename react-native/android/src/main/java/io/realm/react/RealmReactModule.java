@@ -164,9 +164,11 @@ class RealmReactModule extends ReactContextBaseJavaModule {
         worker.postDelayed(new Runnable() {
             @Override
             public void run() {
+                // tryRunTask() sleeps until a task is added or a short timeout passes, so it can be
+                // rescheduled right away without busy waiting.
                 boolean stop = tryRunTask();
                 if (!stop) {
-                    worker.postDelayed(this, 10);
+                    worker.post(this);
                 }
             }
         }, 10);
@@ -200,6 +202,10 @@ class RealmReactModule extends ReactContextBaseJavaModule {
         @Override
         public Response serve(IHTTPSession session) {
             final String cmdUri = session.getUri();
+            if (isBinaryChromeDebugCommand(cmdUri)) {
+                return serveBinary(session, cmdUri);
+            }
+
             final HashMap<String, String> map = new HashMap<String, String>();
             try {
                 session.parseBody(map);
@@ -220,6 +226,26 @@ class RealmReactModule extends ReactContextBaseJavaModule {
             response.addHeader("Access-Control-Allow-Origin", "http://localhost:8081");
             return response;
         }
+
+        // Sessions using the binary protocol post CBOR, which must be read as raw bytes.
+        private Response serveBinary(IHTTPSession session, String cmdUri) {
+            byte[] body;
+            try {
+                String contentLength = session.getHeaders().get("content-length");
+                body = new byte[contentLength != null ? Integer.parseInt(contentLength) : 0];
+                new DataInputStream(session.getInputStream()).readFully(body);
+            } catch (IOException e) {
+                e.printStackTrace();
+                body = new byte[0];
+            }
+
+            final byte[] binaryResponse = processChromeDebugBinaryCommand(cmdUri, body);
+
+            Response response = newFixedLengthResponse(Response.Status.OK, "application/cbor",
+                    new ByteArrayInputStream(binaryResponse), binaryResponse.length);
+            response.addHeader("Access-Control-Allow-Origin", "http://localhost:8081");
+            return response;
+        }
     }
 
     // return true if the Realm API was injected (return false when running in Chrome Debug)
@@ -237,6 +263,12 @@ class RealmReactModule extends ReactContextBaseJavaModule {
     // this receives one command from Chrome debug then return the processing we should post back
     private native String processChromeDebugCommand(String cmd, String args);
 
+    // return true if the command from Chrome debug is CBOR encoded
+    private native boolean isBinaryChromeDebugCommand(String cmd);
+
+    // this receives one CBOR encoded command from Chrome debug then return the processing we should post back
+    private native byte[] processChromeDebugBinaryCommand(String cmd, byte[] args);
+
     // this receives one command from Chrome debug then return the processing we should post back
     private native boolean tryRunTask();
 }
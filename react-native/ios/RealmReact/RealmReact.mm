@@ -227,18 +227,25 @@ RCT_REMAP_METHOD(emit, emitEvent:(NSString *)eventName withObject:(id)object) {
         try {
             NSData *responseData;
 
-            if (rpcServer) {
-                json args = json::parse([[(GCDWebServerDataRequest *)request text] UTF8String]);
-                std::string responseText = rpcServer->perform_request(request.path.UTF8String, args).dump();
+            NSString *contentType = @"application/json";
 
-                responseData = [NSData dataWithBytes:responseText.c_str() length:responseText.length()];
+            if (rpcServer) {
+                std::string path = request.path.UTF8String;
+                NSData *requestData = [(GCDWebServerDataRequest *)request data];
+                std::string body((const char *)requestData.bytes, requestData.length);
+                if (rpcServer->is_binary_request(path)) {
+                    contentType = @"application/cbor";
+                }
+                std::string responseText = rpcServer->perform_encoded_request(path, body);
+
+                responseData = [NSData dataWithBytes:responseText.data() length:responseText.length()];
             }
             else {
                 // we have been deallocated
                 responseData = [NSData data];
             }
 
-            response = [[GCDWebServerDataResponse alloc] initWithData:responseData contentType:@"application/json"];
+            response = [[GCDWebServerDataResponse alloc] initWithData:responseData contentType:contentType];
         }
         catch(std::exception &ex) {
             NSLog(@"Invalid RPC request - %@", [(GCDWebServerDataRequest *)request text]);
@@ -113,6 +113,30 @@ JNIEXPORT jstring JNICALL Java_io_realm_react_RealmReactModule_processChromeDebu
     return env->NewStringUTF(response.dump().c_str());
 }
 
+JNIEXPORT jboolean JNICALL Java_io_realm_react_RealmReactModule_isBinaryChromeDebugCommand
+  (JNIEnv *env, jclass, jstring chrome_cmd)
+{
+    const char* cmd = env->GetStringUTFChars(chrome_cmd, NULL);
+    jboolean result = s_rpc_server->is_binary_request(cmd);
+    env->ReleaseStringUTFChars(chrome_cmd, cmd);
+    return result;
+}
+
+JNIEXPORT jbyteArray JNICALL Java_io_realm_react_RealmReactModule_processChromeDebugBinaryCommand
+  (JNIEnv *env, jclass, jstring chrome_cmd, jbyteArray chrome_args)
+{
+    const char* cmd = env->GetStringUTFChars(chrome_cmd, NULL);
+    jsize length = env->GetArrayLength(chrome_args);
+    std::string args(length, '\0');
+    env->GetByteArrayRegion(chrome_args, 0, length, reinterpret_cast<jbyte*>(&args[0]));
+    std::string response = s_rpc_server->perform_encoded_request(cmd, args);
+    env->ReleaseStringUTFChars(chrome_cmd, cmd);
+
+    jbyteArray result = env->NewByteArray(response.size());
+    env->SetByteArrayRegion(result, 0, response.size(), reinterpret_cast<const jbyte*>(response.data()));
+    return result;
+}
+
 JNIEXPORT jboolean JNICALL Java_io_realm_react_RealmReactModule_tryRunTask
 (JNIEnv *env, jclass)
 {
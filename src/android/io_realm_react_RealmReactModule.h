@@ -29,6 +29,20 @@ JNIEXPORT jlong JNICALL Java_io_realm_react_RealmReactModule_setupChromeDebugMod
 JNIEXPORT jstring JNICALL Java_io_realm_react_RealmReactModule_processChromeDebugCommand
   (JNIEnv *, jclass, jstring, jstring);
 
+/*
+ * Class:     io_realm_react_RealmReactModule
+ * Method:    isBinaryChromeDebugCommand
+ */
+JNIEXPORT jboolean JNICALL Java_io_realm_react_RealmReactModule_isBinaryChromeDebugCommand
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     io_realm_react_RealmReactModule
+ * Method:    processChromeDebugBinaryCommand
+ */
+JNIEXPORT jbyteArray JNICALL Java_io_realm_react_RealmReactModule_processChromeDebugBinaryCommand
+  (JNIEnv *, jclass, jstring, jbyteArray);
+
 /*
  * Class:     io_realm_react_RealmReactModule
  * Method:    tryRunTask
@@ -18,74 +18,117 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
-#include <deque>
 #include <mutex>
 
 #include <realm/util/optional.hpp>
 
 namespace realm {
 
+// A multiple-producer, single-consumer FIFO queue: items added with push_front() are removed in the
+// same order by pop_back(). Pushing and popping are lock-free (an intrusive linked queue with a stub
+// node). The mutex is only used to put the consumer to sleep when the queue is empty, and producers
+// only take it when the consumer is actually waiting.
+//
+// Only one thread may pop at a time.
 template <typename T>
 class ConcurrentDeque {
 public:
-    T pop_back() {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        m_condition.wait(lock, [this] { return !m_deque.empty(); });
-        return do_pop_back();
+    ConcurrentDeque() : m_head(new Node), m_tail(m_head.load()) {}
+
+    ~ConcurrentDeque() {
+        while (m_tail) {
+            Node *next = m_tail->next.load();
+            delete m_tail;
+            m_tail = next;
+        }
     }
 
-    T pop_if(std::function<bool(const T&)> predicate) {
-        std::unique_lock<std::mutex> lock(m_mutex);
+    ConcurrentDeque(const ConcurrentDeque&) = delete;
+    ConcurrentDeque& operator=(const ConcurrentDeque&) = delete;
 
-        for (auto it = m_deque.begin(); it != m_deque.end();) {
-            if (predicate(*it)) {
-                T item = std::move(*it);
-                m_deque.erase(it);
-                return item;
+    T pop_back() {
+        while (true) {
+            if (auto item = try_pop()) {
+                return std::move(*item);
             }
-            else {
-                ++it;
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_waiting.store(true);
+            if (auto item = try_pop()) {
+                m_waiting.store(false);
+                return std::move(*item);
             }
+            m_condition.wait(lock);
+            m_waiting.store(false);
         }
-
-        return nullptr;
     }
 
     util::Optional<T> try_pop_back(size_t timeout) {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        m_condition.wait_for(lock, std::chrono::milliseconds(timeout),
-                             [this] { return !m_deque.empty(); });
-        return m_deque.empty() ? util::none : util::make_optional(do_pop_back());
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+        while (true) {
+            if (auto item = try_pop()) {
+                return item;
+            }
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_waiting.store(true);
+            if (auto item = try_pop()) {
+                m_waiting.store(false);
+                return item;
+            }
+            bool timed_out = m_condition.wait_until(lock, deadline) == std::cv_status::timeout;
+            m_waiting.store(false);
+            if (timed_out) {
+                return try_pop();
+            }
+        }
     }
 
     void push_front(T&& item) {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        m_deque.push_front(std::move(item));
-        lock.unlock();
-        m_condition.notify_one();
-    }
+        Node *node = new Node;
+        node->value = std::move(item);
+
+        Node *previous = m_head.exchange(node);
+        previous->next.store(node);
 
-    void push_back(T&& item) {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        m_deque.push_back(std::move(item));
-        lock.unlock();
-        m_condition.notify_one();
+        if (m_waiting.load()) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_condition.notify_one();
+        }
     }
 
+    // Only reliable when called from the consuming thread.
     bool empty() {
-        std::lock_guard <std::mutex> lock(m_mutex);
-        return m_deque.empty();
+        return m_tail->next.load() == nullptr;
     }
 
 private:
-    std::condition_variable m_condition;
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        util::Optional<T> value;
+    };
+
+    // Producers append at the head; the consumer owns the tail, which is always an empty stub node.
+    std::atomic<Node*> m_head;
+    Node *m_tail;
+
+    std::atomic<bool> m_waiting{false};
     std::mutex m_mutex;
-    std::deque<T> m_deque;
+    std::condition_variable m_condition;
+
+    util::Optional<T> try_pop() {
+        Node *next = m_tail->next.load();
+        if (!next) {
+            return util::none;
+        }
 
-    T do_pop_back() {
-        T item = std::move(m_deque.back());
-        m_deque.pop_back();
+        util::Optional<T> item = std::move(next->value);
+        next->value = util::none;
+        delete m_tail;
+        m_tail = next;
         return item;
     }
 };
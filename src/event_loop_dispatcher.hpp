@@ -18,9 +18,14 @@
 
 #pragma once
 
-#include <queue>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <thread>
 #include <tuple>
 #include <mutex>
+#include <vector>
 
 #include "util/event_loop_signal.hpp"
 
@@ -38,54 +43,165 @@ constexpr auto apply(Tuple t, F f) {
 }
 
 namespace realm {
+namespace _impl {
+
+// The event loop signal shared by all dispatchers created on one thread. A dispatcher with pending
+// invocations pushes its state onto a lock-free list, and the signal runs only those states, so an
+// idle dispatcher costs nothing on the event loop.
+class DispatchQueue {
+public:
+    struct Entry {
+        virtual ~Entry() = default;
+        virtual void drain() = 0;
+    };
+
+    static std::shared_ptr<DispatchQueue> for_current_thread()
+    {
+        static thread_local std::weak_ptr<DispatchQueue> t_queue;
+        auto queue = t_queue.lock();
+        if (!queue) {
+            queue = std::make_shared<DispatchQueue>();
+            t_queue = queue;
+        }
+        return queue;
+    }
+
+    DispatchQueue() : m_signal(Callback{this}) {}
+
+    ~DispatchQueue()
+    {
+        Node* node = m_head.exchange(nullptr);
+        while (node) {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    // Can be called from any thread.
+    void schedule(std::shared_ptr<Entry> entry)
+    {
+        Node* node = new Node{std::move(entry), m_head.load()};
+        while (!m_head.compare_exchange_weak(node->next, node)) {
+        }
+        m_signal.notify();
+    }
+
+private:
+    struct Node {
+        std::shared_ptr<Entry> entry;
+        Node* next;
+    };
+
+    struct Callback {
+        DispatchQueue* m_queue;
+
+        void operator()()
+        {
+            m_queue->drain();
+        }
+    };
+
+    std::atomic<Node*> m_head{nullptr};
+    EventLoopSignal<Callback> m_signal;
+
+    void drain()
+    {
+        // Entries were pushed in front of each other, so reverse them to run them in order.
+        std::vector<std::shared_ptr<Entry>> entries;
+        for (Node* node = m_head.exchange(nullptr); node;) {
+            entries.push_back(std::move(node->entry));
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+
+        for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+            try {
+                (*it)->drain();
+            }
+            catch (...) {
+                // Leave the remaining entries for the next wakeup.
+                for (++it; it != entries.rend(); ++it) {
+                    schedule(std::move(*it));
+                }
+                throw;
+            }
+        }
+    }
+};
+
+} // namespace _impl
+
 template <class F>
 class EventLoopDispatcher;
 
 template <typename... Args>
 class EventLoopDispatcher<void(Args...)> {
     using Tuple = std::tuple<typename std::remove_reference<Args>::type...>;
-private:
-    
-    struct Callback;
 
-    struct State {
+public:
+    // Combines the arguments of an invocation which is still waiting to run with those of a new one.
+    using Merge = std::function<Tuple(const Tuple& pending, Tuple&& incoming)>;
+
+    // A Merge which keeps only the latest arguments, e.g. for progress notifications.
+    static Merge latest()
+    {
+        return [](const Tuple&, Tuple&& incoming) { return std::move(incoming); };
+    }
+
+private:
+    struct State : _impl::DispatchQueue::Entry {
     public:
-        State(std::function<void(Args...)> func) : 
+        State(std::function<void(Args...)> func, Merge merge) :
             m_func(func),
-            m_signal(nullptr) 
+            m_merge(std::move(merge)),
+            m_queue(_impl::DispatchQueue::for_current_thread())
         { 
         }
         
         const std::function<void(Args...)> m_func;
-        std::queue<Tuple> m_invocations;
+        const Merge m_merge;
+        // Keeps the queue, and with it the event loop signal, alive while invocations are pending.
+        const std::shared_ptr<_impl::DispatchQueue> m_queue;
+        std::deque<Tuple> m_invocations;
         std::mutex m_mutex;
-        std::shared_ptr<EventLoopSignal<Callback>> m_signal;
-    };
-    const std::shared_ptr<State> m_state;
-    
-    struct Callback {
-        std::shared_ptr<State> m_state;
-        
-    public:
-        void operator()()
+        // Set while this state is on the queue's ready list.
+        std::atomic<bool> m_scheduled{false};
+
+        void drain() override
         {
-            std::unique_lock<std::mutex> lock(m_state->m_mutex);
-            while (!m_state->m_invocations.empty()) {
-                auto& tuple = m_state->m_invocations.front();
-                ::_apply_polyfill::apply(tuple, m_state->m_func);
-                m_state->m_invocations.pop();
+            // Cleared before taking the invocations, so that an invocation added after this point
+            // schedules the state again. Run them without holding the lock, so that the notifying
+            // thread never waits for JS code.
+            m_scheduled.store(false);
+
+            std::deque<Tuple> invocations;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                invocations.swap(m_invocations);
+            }
+            for (auto& tuple : invocations) {
+                ::_apply_polyfill::apply(tuple, m_func);
             }
-            m_state->m_signal.reset();
         }
     };
-    const std::shared_ptr<EventLoopSignal<Callback>> m_signal;
+    const std::shared_ptr<State> m_state;
     
     const std::thread::id m_thread = std::this_thread::get_id();
     
 public:
     EventLoopDispatcher(std::function<void(Args...)> func)
-    : m_state(std::make_shared<State>(func))
-    , m_signal(std::make_shared<EventLoopSignal<Callback>>(Callback{m_state}))
+    : EventLoopDispatcher(std::move(func), nullptr)
+    {
+        
+    }
+
+    // With a `merge` function, an invocation made while an earlier one is still waiting to run on the
+    // target thread is merged into it instead of being queued, so the function runs at most once
+    // per wakeup.
+    EventLoopDispatcher(std::function<void(Args...)> func, Merge merge)
+    : m_state(std::make_shared<State>(func, std::move(merge)))
     {
         
     }
@@ -101,10 +217,18 @@ public:
         
         {
             std::unique_lock<std::mutex> lock(m_state->m_mutex);
-            m_state->m_signal = m_signal;
-            m_state->m_invocations.push(std::make_tuple(args...));
+            if (m_state->m_merge && !m_state->m_invocations.empty()) {
+                Tuple merged = m_state->m_merge(m_state->m_invocations.back(), Tuple(args...));
+                m_state->m_invocations.pop_back();
+                m_state->m_invocations.push_back(std::move(merged));
+            }
+            else {
+                m_state->m_invocations.push_back(std::make_tuple(args...));
+            }
+        }
+        if (!m_state->m_scheduled.exchange(true)) {
+            m_state->m_queue->schedule(m_state);
         }
-        m_signal->notify();
     }
 };
 }
@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2018 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "event_loop_dispatcher.hpp"
+#include "js_collection.hpp"
+#include "js_list.hpp"
+#include "js_realm_object.hpp"
+#include "js_results.hpp"
+#include "notification_scheduler.hpp"
+
+namespace realm {
+namespace js {
+
+template<typename T>
+class RealmClass;
+
+// Observes a set of collections and objects, and calls its callback once with the changes of all of
+// them. The changes are collected while the object store delivers the notifications for a new
+// version, and handed to JS on the next turn of the event loop, after that delivery is complete.
+// If further versions are delivered before that turn, their changes are merged into those already
+// pending, so each target appears at most once per batch with the changes up to the latest version.
+template<typename T>
+class BatchListener : public _impl::DispatchQueue::Entry, public std::enable_shared_from_this<BatchListener<T>> {
+    using ContextType = typename T::Context;
+    using FunctionType = typename T::Function;
+    using ObjectType = typename T::Object;
+    using ValueType = typename T::Value;
+    using Object = js::Object<T>;
+    using Value = js::Value<T>;
+
+  public:
+    BatchListener(ContextType ctx, FunctionType callback, std::weak_ptr<realm::Realm> realm)
+    : m_context(Context<T>::get_global_context(ctx))
+    , m_callback(ctx, callback)
+    , m_realm(std::move(realm))
+    , m_queue(_impl::DispatchQueue::for_current_thread())
+    {
+    }
+
+    // Must be called after the listener is owned by a shared_ptr.
+    void observe(ContextType ctx, ObjectType target);
+
+    // Stops observing. A batch which is already scheduled is dropped.
+    void cancel() {
+        m_tokens.clear();
+        m_targets.clear();
+        m_pending.clear();
+    }
+
+    void drain() override;
+
+  private:
+    struct Target {
+        Protected<ObjectType> target;
+        bool is_object;
+        // The changes since the last batch.
+        PendingChanges changes;
+    };
+
+    Protected<typename T::GlobalContext> m_context;
+    Protected<FunctionType> m_callback;
+    std::weak_ptr<realm::Realm> m_realm;
+    const std::shared_ptr<_impl::DispatchQueue> m_queue;
+
+    std::vector<NotificationToken> m_tokens;
+    std::vector<Target> m_targets;
+    // The indexes in m_targets of the targets with changes, in the order they first changed.
+    std::vector<size_t> m_pending;
+    bool m_scheduled = false;
+
+    template<typename U>
+    void add_callback(U &observable, ContextType ctx, ObjectType target, bool is_object);
+};
+
+template<typename T>
+void BatchListener<T>::observe(ContextType ctx, ObjectType target) {
+    if (Object::template is_instance<ResultsClass<T>>(ctx, target)) {
+        add_callback(*get_internal<T, ResultsClass<T>>(target), ctx, target, false);
+    }
+    else if (Object::template is_instance<ListClass<T>>(ctx, target)) {
+        add_callback(*get_internal<T, ListClass<T>>(target), ctx, target, false);
+    }
+    else if (Object::template is_instance<RealmObjectClass<T>>(ctx, target)) {
+        add_callback(*get_internal<T, RealmObjectClass<T>>(target), ctx, target, true);
+    }
+    else {
+        throw std::invalid_argument("Batch listeners can only observe Realm objects, results and lists.");
+    }
+}
+
+template<typename T>
+template<typename U>
+void BatchListener<T>::add_callback(U &observable, ContextType ctx, ObjectType target, bool is_object) {
+    std::weak_ptr<BatchListener<T>> weak_self = this->shared_from_this();
+    size_t index = m_targets.size();
+    m_targets.push_back({Protected<ObjectType>(ctx, target), is_object, {}});
+
+    m_tokens.push_back(observable.add_notification_callback([=](CollectionChangeSet const& change_set, std::exception_ptr) {
+        auto self = weak_self.lock();
+        // The initial notification carries no changes and is not part of any batch.
+        if (!self || change_set.empty() || index >= self->m_targets.size()) {
+            return;
+        }
+
+        auto &pending = self->m_targets[index];
+        if (pending.changes.empty()) {
+            self->m_pending.push_back(index);
+        }
+        pending.changes.add(change_set);
+
+        if (!self->m_scheduled) {
+            self->m_scheduled = true;
+            self->m_queue->schedule(self);
+        }
+    }));
+}
+
+template<typename T>
+void BatchListener<T>::drain() {
+    m_scheduled = false;
+    SharedRealm realm = m_realm.lock();
+    if (!realm || m_pending.empty()) {
+        return;
+    }
+
+    std::vector<size_t> pending;
+    pending.swap(m_pending);
+
+    HANDLESCOPE
+
+    std::vector<ValueType> changes;
+    changes.reserve(pending.size());
+    for (size_t index : pending) {
+        auto &target_changes = m_targets[index];
+        CollectionChangeSet change_set = target_changes.changes.finalize();
+
+        ObjectType target = target_changes.target;
+        ObjectType entry = Object::create_empty(m_context);
+        Object::set_property(m_context, entry, "object", target);
+        if (target_changes.is_object) {
+            auto realm_object = get_internal<T, RealmObjectClass<T>>(target);
+            Object::set_property(m_context, entry, "changes",
+                                 RealmObjectClass<T>::create_object_change_set(m_context, *realm_object, change_set));
+        }
+        else {
+            Object::set_property(m_context, entry, "changes",
+                                 CollectionClass<T>::create_collection_change_set(m_context, change_set));
+        }
+        changes.push_back(entry);
+    }
+
+    ObjectType realm_object = create_object<T, RealmClass<T>>(m_context, new SharedRealm(realm));
+    ValueType arguments[] = {realm_object, Object::create_array(m_context, changes)};
+    Function<T>::callback(m_context, m_callback, realm_object, 2, arguments);
+}
+
+} // js
+} // realm
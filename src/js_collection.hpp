@@ -43,15 +43,136 @@ struct CollectionClass : ClassDefinition<T, Collection, ObservableClass<T>> {
 
     std::string const name = "Collection";
 
-    static inline ValueType create_collection_change_set(ContextType ctx, const CollectionChangeSet &change_set);
+    // How the index sets of a change set are handed to a listener.
+    enum class IndexFormat {
+        Array,       // an array of numbers
+        Uint32Array, // a Uint32Array of indexes
+        Ranges,      // a Uint32Array of [start, count] pairs
+    };
+
+    // The options accepted by `addListener()` after the callback.
+    struct ListenerOptions {
+        IndexFormat index_format = IndexFormat::Array;
+        std::vector<std::string> key_paths;
+        std::chrono::milliseconds throttle{0};
+        std::chrono::milliseconds debounce{0};
+        // Listeners with a higher priority are called first when deliveries are time-sliced.
+        int priority = 0;
+        bool weak = false;
+    };
+
+    // Returns the delay given by the property `name` of `options`, if any.
+    static std::chrono::milliseconds validated_get_interval(ContextType ctx, const ObjectType &options, const String<T> &name);
+
+    static ListenerOptions validated_to_listener_options(ContextType ctx, const ValueType &value);
+
+    static inline ValueType create_collection_change_set(ContextType ctx, const CollectionChangeSet &change_set,
+                                                         IndexFormat format = IndexFormat::Array);
 };
 
 template<typename T>
-typename T::Value CollectionClass<T>::create_collection_change_set(ContextType ctx, const CollectionChangeSet &change_set)
+typename CollectionClass<T>::ListenerOptions CollectionClass<T>::validated_to_listener_options(ContextType ctx, const ValueType &value)
+{
+    static const String<T> index_format_string = "indexFormat";
+    static const String<T> key_paths_string = "keyPaths";
+    static const String<T> throttle_string = "throttleMs";
+    static const String<T> debounce_string = "debounceMs";
+    static const String<T> priority_string = "priority";
+    static const String<T> weak_string = "weak";
+
+    ListenerOptions options;
+    if (Value::is_undefined(ctx, value)) {
+        return options;
+    }
+
+    auto object = Value::validated_to_object(ctx, value, "options");
+    auto index_format = Object::get_property(ctx, object, index_format_string);
+    if (!Value::is_undefined(ctx, index_format)) {
+        std::string format = Value::validated_to_string(ctx, index_format, "indexFormat");
+        if (format == "array") {
+            options.index_format = IndexFormat::Array;
+        }
+        else if (format == "uint32") {
+            options.index_format = IndexFormat::Uint32Array;
+        }
+        else if (format == "ranges") {
+            options.index_format = IndexFormat::Ranges;
+        }
+        else {
+            throw std::invalid_argument(util::format("Unknown index format '%1'. Expected 'array', 'uint32' or 'ranges'.", format));
+        }
+    }
+
+    auto key_paths = Object::get_property(ctx, object, key_paths_string);
+    if (!Value::is_undefined(ctx, key_paths)) {
+        auto array = Value::validated_to_array(ctx, key_paths, "keyPaths");
+        uint32_t count = Object::validated_get_length(ctx, array);
+        for (uint32_t i = 0; i < count; i++) {
+            options.key_paths.push_back(Value::validated_to_string(ctx, Object::get_property(ctx, array, i), "keyPaths"));
+        }
+    }
+
+    options.throttle = validated_get_interval(ctx, object, throttle_string);
+    options.debounce = validated_get_interval(ctx, object, debounce_string);
+
+    auto priority = Object::get_property(ctx, object, priority_string);
+    if (!Value::is_undefined(ctx, priority)) {
+        options.priority = static_cast<int>(Value::validated_to_number(ctx, priority, "priority"));
+    }
+
+    auto weak = Object::get_property(ctx, object, weak_string);
+    if (!Value::is_undefined(ctx, weak)) {
+        options.weak = Value::validated_to_boolean(ctx, weak, "weak");
+    }
+    return options;
+}
+
+template<typename T>
+std::chrono::milliseconds CollectionClass<T>::validated_get_interval(ContextType ctx, const ObjectType &options, const String<T> &name)
+{
+    auto value = Object::get_property(ctx, options, name);
+    if (Value::is_undefined(ctx, value)) {
+        return std::chrono::milliseconds(0);
+    }
+
+    std::string property_name = name;
+    double interval = Value::validated_to_number(ctx, value, property_name.c_str());
+    if (!(interval >= 0)) {
+        throw std::invalid_argument(util::format("'%1' must not be negative.", property_name));
+    }
+    return std::chrono::milliseconds(static_cast<int64_t>(interval));
+}
+
+template<typename T>
+typename T::Value CollectionClass<T>::create_collection_change_set(ContextType ctx, const CollectionChangeSet &change_set,
+                                                                   IndexFormat format)
 {
     ObjectType object = Object::create_empty(ctx);
     std::vector<ValueType> scratch;
-    auto make_array = [&](realm::IndexSet const& index_set) {
+    std::vector<uint32_t> packed;
+    auto make_array = [&](realm::IndexSet const& index_set) -> ObjectType {
+        switch (format) {
+            case IndexFormat::Uint32Array:
+                packed.clear();
+                packed.reserve(index_set.count());
+                for (auto index : index_set.as_indexes()) {
+                    packed.push_back(static_cast<uint32_t>(index));
+                }
+                return Object::create_uint32_array(ctx, packed);
+
+            case IndexFormat::Ranges:
+                // IndexSet stores its contents as [begin, end) ranges, so this does not visit every index.
+                packed.clear();
+                for (auto& range : index_set) {
+                    packed.push_back(static_cast<uint32_t>(range.first));
+                    packed.push_back(static_cast<uint32_t>(range.second - range.first));
+                }
+                return Object::create_uint32_array(ctx, packed);
+
+            case IndexFormat::Array:
+                break;
+        }
+
         scratch.clear();
         scratch.reserve(index_set.count());
         for (auto index : index_set.as_indexes()) {
@@ -0,0 +1,223 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2018 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "event_loop_dispatcher.hpp"
+
+#include <realm/util/file.hpp>
+#include <realm/util/optional.hpp>
+
+namespace realm {
+namespace js {
+
+// Runs long file operations (compaction and writing copies) on a background thread so that
+// the JS thread is not blocked for the duration of the copy. Operations are queued and
+// executed one at a time in the order they were started, so scheduling a compaction and a
+// backup back to back does not make them compete for disk bandwidth. Core does not report progress while writing a file, so progress is
+// derived from the size of the file being written.
+class FileOperation {
+  public:
+    using ProgressHandler = void(uint64_t transferred_bytes, uint64_t transferable_bytes);
+    using CompletionHandler = void(std::string error, bool result);
+    using OperationID = uint64_t;
+
+    struct Config {
+        // Performs the operation. Called on the background thread.
+        std::function<bool()> work;
+        // Removes any output if the operation is cancelled after it started. May be empty.
+        std::function<void()> rollback;
+        // The file being written, which is watched to report progress.
+        std::string output_path;
+        // The file holding the result once the operation has completed.
+        std::string result_path;
+        // An estimate of the final size of the output file.
+        uint64_t expected_size = 0;
+        std::chrono::milliseconds progress_interval{100};
+    };
+
+    static OperationID start(Config config, util::Optional<EventLoopDispatcher<ProgressHandler>> progress,
+                             EventLoopDispatcher<CompletionHandler> completion) {
+        std::lock_guard<std::mutex> lock(mutex());
+        auto state = std::make_shared<State>();
+        state->can_rollback = bool(config.rollback);
+        OperationID id = next_id()++;
+        registry()[id] = state;
+        queue().push_back({id, std::move(state), std::move(config), std::move(progress), std::move(completion)});
+
+        // A single thread drains the queue, and exits once it is empty.
+        if (!worker_running()) {
+            worker_running() = true;
+            std::thread(run_queue).detach();
+        }
+        return id;
+    }
+
+    // Operations which have not started yet are skipped. Operations which are already running cannot be
+    // interrupted, so they can only be cancelled if their output can be removed once they complete.
+    static bool cancel(OperationID id) {
+        std::lock_guard<std::mutex> lock(mutex());
+        auto it = registry().find(id);
+        if (it == registry().end()) {
+            return false;
+        }
+        auto& state = *it->second;
+        if (state.started && !state.can_rollback) {
+            return false;
+        }
+        state.cancelled = true;
+        return true;
+    }
+
+    static uint64_t file_size(const std::string& path) {
+        try {
+            return util::File(path, util::File::mode_Read).get_size();
+        }
+        catch (std::exception const&) {
+            return 0;
+        }
+    }
+
+  private:
+    struct State {
+        bool started = false;
+        bool cancelled = false;
+        bool can_rollback = false;
+    };
+
+    struct Operation {
+        OperationID id;
+        std::shared_ptr<State> state;
+        Config config;
+        util::Optional<EventLoopDispatcher<ProgressHandler>> progress;
+        EventLoopDispatcher<CompletionHandler> completion;
+    };
+
+    static void run_queue() {
+        while (true) {
+            util::Optional<Operation> operation;
+            bool cancelled;
+            {
+                std::lock_guard<std::mutex> lock(mutex());
+                if (queue().empty()) {
+                    worker_running() = false;
+                    return;
+                }
+                operation = std::move(queue().front());
+                queue().pop_front();
+                cancelled = operation->state->cancelled;
+                operation->state->started = true;
+                if (cancelled) {
+                    registry().erase(operation->id);
+                }
+            }
+
+            if (cancelled) {
+                operation->completion("Operation was cancelled.", false);
+                continue;
+            }
+            run(*operation);
+        }
+    }
+
+    static void run(Operation& operation) {
+        auto& config = operation.config;
+        auto& progress = operation.progress;
+
+        // The operation is only removed from the registry together with checking whether it was
+        // cancelled, so a successful cancel() is never ignored.
+        auto finish = [&](bool* cancelled) {
+            std::lock_guard<std::mutex> lock(mutex());
+            registry().erase(operation.id);
+            if (cancelled) {
+                *cancelled = operation.state->cancelled;
+            }
+        };
+
+        auto future = std::async(std::launch::async, config.work);
+        uint64_t last_reported = 0;
+        while (future.wait_for(config.progress_interval) != std::future_status::ready) {
+            uint64_t size = file_size(config.output_path);
+            if (progress && size != last_reported) {
+                (*progress)(size, std::max(size, config.expected_size));
+                last_reported = size;
+            }
+        }
+
+        bool result = false;
+        try {
+            result = future.get();
+        }
+        catch (std::exception const& e) {
+            finish(nullptr);
+            operation.completion(e.what(), false);
+            return;
+        }
+
+        bool cancelled = false;
+        finish(&cancelled);
+        if (cancelled) {
+            config.rollback();
+            operation.completion("Operation was cancelled.", false);
+            return;
+        }
+
+        if (progress) {
+            uint64_t size = file_size(config.result_path);
+            (*progress)(size, size);
+        }
+        operation.completion("", result);
+    }
+
+    static OperationID& next_id() {
+        static OperationID id = 1;
+        return id;
+    }
+
+    static bool& worker_running() {
+        static bool running = false;
+        return running;
+    }
+
+    // Guards the registry, the queue and the state of every operation.
+    static std::mutex& mutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static std::map<OperationID, std::shared_ptr<State>>& registry() {
+        static std::map<OperationID, std::shared_ptr<State>> operations;
+        return operations;
+    }
+
+    static std::deque<Operation>& queue() {
+        static std::deque<Operation> operations;
+        return operations;
+    }
+};
+
+} // js
+} // realm
@@ -40,7 +40,7 @@ class List : public realm::List {
     List(std::shared_ptr<realm::Realm> r, const ObjectSchema& s, LinkViewRef l) noexcept : realm::List(r, l) {}
     List(const realm::List &l) : realm::List(l) {}
 
-    std::vector<std::pair<Protected<typename T::Function>, NotificationToken>> m_notification_tokens;
+    NotificationTokens<T, NotificationToken> m_notification_tokens;
 };
 
 template<typename T>
@@ -100,6 +100,7 @@ struct ListClass : ClassDefinition<T, realm::js::List<T>, CollectionClass<T>> {
         {"max", wrap<compute_aggregate_on_collection<ListClass<T>, AggregateFunc::Max>>},
         {"sum", wrap<compute_aggregate_on_collection<ListClass<T>, AggregateFunc::Sum>>},
         {"avg", wrap<compute_aggregate_on_collection<ListClass<T>, AggregateFunc::Avg>>},
+        {"count", wrap<compute_count_on_collection<ListClass<T>>>},
         {"addListener", wrap<add_listener>},
         {"removeListener", wrap<remove_listener>},
         {"removeAllListeners", wrap<remove_all_listeners>},
@@ -16,9 +16,16 @@
 //
 ////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
 #include "platform.hpp"
 #include "realm_coordinator.hpp"
+#include "shared_realm.hpp"
 #include "js_types.hpp"
+#include "js_realm.hpp"
 
 #if REALM_ENABLE_SYNC
 #include "sync/sync_manager.hpp"
@@ -52,7 +59,91 @@ void delete_all_realms() {
     realm::remove_realm_files_from_directory(realm::default_realm_file_directory());
 }
 
+// Realms are cached per execution context, so the Realms opened by a context which is torn down
+// must be closed before another context can be created with the same id.
+static std::mutex s_context_realms_mutex;
+static std::unordered_map<AbstractExecutionContextID, std::vector<WeakRealm>> s_context_realms;
+
+void register_realm(AbstractExecutionContextID context, SharedRealm const& realm) {
+    std::lock_guard<std::mutex> lock(s_context_realms_mutex);
+    auto& realms = s_context_realms[context];
+    realms.erase(std::remove_if(realms.begin(), realms.end(), [&](WeakRealm const& weak_realm) {
+        auto existing = weak_realm.lock();
+        return !existing || existing == realm;
+    }), realms.end());
+    realms.push_back(realm);
+}
+
+void close_realms_for_execution_context(AbstractExecutionContextID context) {
+    std::vector<WeakRealm> realms;
+    {
+        std::lock_guard<std::mutex> lock(s_context_realms_mutex);
+        auto it = s_context_realms.find(context);
+        if (it == s_context_realms.end()) {
+            return;
+        }
+        realms = std::move(it->second);
+        s_context_realms.erase(it);
+    }
+
+    for (auto& weak_realm : realms) {
+        if (auto realm = weak_realm.lock()) {
+            realm->close();
+        }
+    }
+}
+
+static std::mutex s_thread_safe_references_mutex;
+static std::map<uint64_t, StoredThreadSafeReference> s_thread_safe_references;
+static uint64_t s_next_thread_safe_reference_id = 1;
+
+uint64_t store_thread_safe_reference(StoredThreadSafeReference reference) {
+    std::lock_guard<std::mutex> lock(s_thread_safe_references_mutex);
+    uint64_t id = s_next_thread_safe_reference_id++;
+    s_thread_safe_references.emplace(id, std::move(reference));
+    return id;
+}
+
+StoredThreadSafeReference take_thread_safe_reference(uint64_t id, std::string const& path) {
+    std::lock_guard<std::mutex> lock(s_thread_safe_references_mutex);
+    auto it = s_thread_safe_references.find(id);
+    if (it == s_thread_safe_references.end()) {
+        throw std::runtime_error("Thread-safe reference has already been resolved or does not exist.");
+    }
+    if (it->second.path != path) {
+        throw std::runtime_error("Thread-safe reference can only be resolved by a Realm opened at '" + it->second.path + "'.");
+    }
+
+    StoredThreadSafeReference reference = std::move(it->second);
+    s_thread_safe_references.erase(it);
+    return reference;
+}
+
+bool release_thread_safe_reference(uint64_t id) {
+    StoredThreadSafeReference reference;
+    {
+        std::lock_guard<std::mutex> lock(s_thread_safe_references_mutex);
+        auto it = s_thread_safe_references.find(id);
+        if (it == s_thread_safe_references.end()) {
+            return false;
+        }
+        reference = std::move(it->second);
+        s_thread_safe_references.erase(it);
+    }
+    // The reference releases its pinned version once it is destroyed outside of the lock.
+    return true;
+}
+
+void clear_thread_safe_references() {
+    std::map<uint64_t, StoredThreadSafeReference> references;
+    {
+        std::lock_guard<std::mutex> lock(s_thread_safe_references_mutex);
+        references.swap(s_thread_safe_references);
+    }
+}
+
 void clear_test_state() {
+    clear_thread_safe_references();
     delete_all_realms();
 #if REALM_ENABLE_SYNC
     for(auto &user : SyncManager::shared().all_logged_in_users()) {
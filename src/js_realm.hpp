@@ -22,6 +22,7 @@
 #include <list>
 #include <map>
 
+#include "js_batch_listener.hpp"
 #include "js_class.hpp"
 #include "js_types.hpp"
 #include "js_util.hpp"
@@ -30,6 +31,8 @@
 #include "js_results.hpp"
 #include "js_schema.hpp"
 #include "js_observable.hpp"
+#include "js_file_operation.hpp"
+#include "listener_registry.hpp"
 
 #if REALM_ENABLE_SYNC
 #include "js_sync.hpp"
@@ -42,6 +45,7 @@
 #include "object_accessor.hpp"
 #include "platform.hpp"
 #include "results.hpp"
+#include "thread_safe_reference.hpp"
 
 #include <realm/disable_sync_to_disk.hpp>
 
@@ -93,24 +97,27 @@ class RealmDelegate : public BindingContext {
         m_constructors.clear();
         m_notifications.clear();
         m_schema_notifications.clear();
+        remove_all_batch_notifications();
     }
 
-    void add_notification(FunctionType notification) {
-        for (auto &handler : m_notifications) {
-            if (handler == notification) {
-                return;
-            }
+    void add_notification(FunctionType notification, std::chrono::milliseconds throttle = {}, std::chrono::milliseconds debounce = {}) {
+        Protected<FunctionType> callback(m_context, notification);
+        if (m_notifications.contains(callback)) {
+            return;
+        }
+
+        std::shared_ptr<NotificationThrottle> notification_throttle;
+        if (throttle.count() > 0 || debounce.count() > 0) {
+            // Only called while the listener, and so this delegate, exists.
+            notification_throttle = NotificationThrottle::create(throttle, debounce, [this, callback](CollectionChangeSet const&) {
+                call_notification(callback, "change");
+            });
         }
-        m_notifications.emplace_back(m_context, notification);
+        m_notifications.add(std::move(callback), std::move(notification_throttle));
     }
 
     void remove_notification(FunctionType notification) {
-        for (auto iter = m_notifications.begin(); iter != m_notifications.end(); ++iter) {
-            if (*iter == notification) {
-                m_notifications.erase(iter);
-                return;
-            }
-        }
+        m_notifications.remove(notification);
     }
 
     void remove_all_notifications() {
@@ -120,34 +127,51 @@ class RealmDelegate : public BindingContext {
     void add_schema_notification(FunctionType notification) {
         SharedRealm realm = m_realm.lock();
         realm->read_group(); // to get the schema change handler going
-        for (auto &handler : m_schema_notifications) {
-            if (handler == notification) {
-                return;
-            }
+        Protected<FunctionType> callback(m_context, notification);
+        if (!m_schema_notifications.contains(callback)) {
+            m_schema_notifications.add(std::move(callback), nullptr);
         }
-        m_schema_notifications.emplace_back(m_context, notification);
     }
 
     void remove_schema_notification(FunctionType notification) {
-        for (auto iter = m_schema_notifications.begin(); iter != m_schema_notifications.end(); ++iter) {
-            if (*iter == notification) {
-                m_schema_notifications.erase(iter);
-                return;
-            }
-        }
+        m_schema_notifications.remove(notification);
     }
 
     void remove_all_schema_notifications() {
         m_schema_notifications.clear();
     }
 
+    std::shared_ptr<BatchListener<T>> add_batch_notification(typename T::Context ctx, FunctionType notification) {
+        remove_batch_notification(notification);
+        auto listener = std::make_shared<BatchListener<T>>(ctx, notification, m_realm);
+        m_batch_notifications.add({m_context, notification}, listener);
+        return listener;
+    }
+
+    void remove_batch_notification(FunctionType notification) {
+        Protected<FunctionType> callback(m_context, notification);
+        if (auto listener = m_batch_notifications.find(callback)) {
+            (*listener)->cancel();
+            m_batch_notifications.remove(callback);
+        }
+    }
+
+    void remove_all_batch_notifications() {
+        m_batch_notifications.for_each([](const Protected<FunctionType>&, std::shared_ptr<BatchListener<T>>& listener) {
+            listener->cancel();
+        });
+        m_batch_notifications.clear();
+    }
+
     ObjectDefaultsMap m_defaults;
     ConstructorMap m_constructors;
 
   private:
     Protected<GlobalContextType> m_context;
-    std::list<Protected<FunctionType>> m_notifications;
-    std::list<Protected<FunctionType>> m_schema_notifications;
+    // The throttle is set for listeners added with a throttle or debounce interval.
+    ListenerRegistry<T, std::shared_ptr<NotificationThrottle>> m_notifications;
+    ListenerRegistry<T, std::nullptr_t> m_schema_notifications;
+    ListenerRegistry<T, std::shared_ptr<BatchListener<T>>> m_batch_notifications;
     std::weak_ptr<realm::Realm> m_realm;
 
     void notify(const char *notification_name) {
@@ -161,10 +185,27 @@ class RealmDelegate : public BindingContext {
         ObjectType realm_object = create_object<T, RealmClass<T>>(m_context, new SharedRealm(realm));
         ValueType arguments[] = {realm_object, Value::from_string(m_context, notification_name)};
 
-        std::list<Protected<FunctionType>> notifications_copy(m_notifications);
-        for (auto &callback : notifications_copy) {
-            Function<T>::callback(m_context, callback, realm_object, 2, arguments);
+        m_notifications.for_each([&](const Protected<FunctionType> &callback, std::shared_ptr<NotificationThrottle> &throttle) {
+            if (throttle) {
+                throttle->add({});
+            }
+            else {
+                Function<T>::callback(m_context, callback, realm_object, 2, arguments);
+            }
+        });
+    }
+
+    void call_notification(const Protected<FunctionType> &callback, const char *notification_name) {
+        HANDLESCOPE
+
+        SharedRealm realm = m_realm.lock();
+        if (!realm) {
+            return;
         }
+
+        ObjectType realm_object = create_object<T, RealmClass<T>>(m_context, new SharedRealm(realm));
+        ValueType arguments[] = {realm_object, Value::from_string(m_context, notification_name)};
+        Function<T>::callback(m_context, callback, realm_object, 2, arguments);
     }
 
     void schema_notify(const char *notification_name, realm::Schema const& schema) {
@@ -179,10 +220,9 @@ class RealmDelegate : public BindingContext {
         ObjectType schema_object = Schema<T>::object_for_schema(m_context, schema);
         ValueType arguments[] = {realm_object, Value::from_string(m_context, notification_name), schema_object};
 
-        std::list<Protected<FunctionType>> notifications_copy(m_schema_notifications);
-        for (auto &callback : notifications_copy) {
+        m_schema_notifications.for_each([&](const Protected<FunctionType> &callback, std::nullptr_t) {
             Function<T>::callback(m_context, callback, realm_object, 3, arguments);
-        }
+        });
     }
 
     friend class RealmClass<T>;
@@ -192,6 +232,21 @@ std::string default_path();
 void set_default_path(std::string path);
 void delete_all_realms();
 void clear_test_state();
+void register_realm(AbstractExecutionContextID, SharedRealm const&);
+void close_realms_for_execution_context(AbstractExecutionContextID);
+
+// Thread-safe references are kept by the binding and handed to JS as plain tokens, which can be
+// posted to another thread and resolved there exactly once.
+struct StoredThreadSafeReference {
+    std::string type;
+    std::string path;
+    std::unique_ptr<ThreadSafeReferenceBase> reference;
+};
+
+uint64_t store_thread_safe_reference(StoredThreadSafeReference);
+StoredThreadSafeReference take_thread_safe_reference(uint64_t id, std::string const& path);
+bool release_thread_safe_reference(uint64_t id);
+void clear_thread_safe_references();
 
 template<typename T>
 class RealmClass : public ClassDefinition<T, SharedRealm, ObservableClass<T>> {
@@ -231,12 +286,17 @@ public:
     static void wait_for_download_completion(ContextType, ObjectType, Arguments, ReturnValue &);
     static void remove_listener(ContextType, ObjectType, Arguments, ReturnValue &);
     static void remove_all_listeners(ContextType, ObjectType, Arguments, ReturnValue &);
+    static void add_batch_listener(ContextType, ObjectType, Arguments, ReturnValue &);
+    static void remove_batch_listener(ContextType, ObjectType, Arguments, ReturnValue &);
     static void close(ContextType, ObjectType, Arguments, ReturnValue &);
     static void compact(ContextType, ObjectType, Arguments, ReturnValue &);
     static void writeCopyTo(ContextType, ObjectType, Arguments, ReturnValue &);
+    static void write_copy_to_async(ContextType, ObjectType, Arguments, ReturnValue &);
     static void delete_model(ContextType, ObjectType, Arguments, ReturnValue &);
     static void object_for_object_id(ContextType, ObjectType, Arguments, ReturnValue&);
     static void privileges(ContextType, ObjectType, Arguments, ReturnValue&);
+    static void create_thread_safe_reference(ContextType, ObjectType, Arguments, ReturnValue&);
+    static void resolve_thread_safe_reference(ContextType, ObjectType, Arguments, ReturnValue&);
 
     // properties
     static void get_empty(ContextType, ObjectType, ReturnValue &);
@@ -259,6 +319,11 @@ public:
     static void clear_test_state(ContextType, ObjectType, Arguments, ReturnValue &);
     static void copy_bundled_realm_files(ContextType, ObjectType, Arguments, ReturnValue &);
     static void delete_file(ContextType, ObjectType, Arguments, ReturnValue &);
+    static void compact_async(ContextType, ObjectType, Arguments, ReturnValue &);
+    static void cancel_file_operation(ContextType, ObjectType, Arguments, ReturnValue &);
+    static void set_notification_budget(ContextType, ObjectType, Arguments, ReturnValue &);
+    static void notification_metrics(ContextType, ObjectType, Arguments, ReturnValue &);
+    static void release_thread_safe_reference(ContextType, ObjectType, Arguments, ReturnValue &);
 
     // static properties
     static void get_default_path(ContextType, ObjectType, ReturnValue &);
@@ -271,6 +336,11 @@ public:
         {"clearTestState", wrap<clear_test_state>},
         {"copyBundledRealmFiles", wrap<copy_bundled_realm_files>},
         {"deleteFile", wrap<delete_file>},
+        {"_compactAsync", wrap<compact_async>},
+        {"_cancelFileOperation", wrap<cancel_file_operation>},
+        {"setNotificationBudget", wrap<set_notification_budget>},
+        {"notificationMetrics", wrap<notification_metrics>},
+        {"releaseThreadSafeReference", wrap<release_thread_safe_reference>},
     };
 
     PropertyMap<T> const static_properties = {
@@ -290,12 +360,17 @@ public:
         {"addListener", wrap<add_listener>},
         {"removeListener", wrap<remove_listener>},
         {"removeAllListeners", wrap<remove_all_listeners>},
+        {"addBatchListener", wrap<add_batch_listener>},
+        {"removeBatchListener", wrap<remove_batch_listener>},
         {"close", wrap<close>},
         {"compact", wrap<compact>},
         {"writeCopyTo", wrap<writeCopyTo>},
+        {"_writeCopyToAsync", wrap<write_copy_to_async>},
         {"deleteModel", wrap<delete_model>},
         {"privileges", wrap<privileges>},
         {"_objectForObjectId", wrap<object_for_object_id>},
+        {"createThreadSafeReference", wrap<create_thread_safe_reference>},
+        {"resolveThreadSafeReference", wrap<resolve_thread_safe_reference>},
  #if REALM_ENABLE_SYNC
         {"_waitForDownload", wrap<wait_for_download_completion>},
  #endif
@@ -336,6 +411,50 @@ public:
         }
     }
 
+    static void start_file_operation(ContextType ctx, FileOperation::Config operation, const ValueType &interval_value,
+                                     const ValueType &progress_value, const ValueType &completion_value, ReturnValue &return_value) {
+        FunctionType completion_function = Value::validated_to_function(ctx, completion_value, "callback");
+        if (!Value::is_undefined(ctx, interval_value)) {
+            double interval = Value::validated_to_number(ctx, interval_value, "progressInterval");
+            if (interval < 1) {
+                throw std::invalid_argument("'progressInterval' must be at least 1 millisecond.");
+            }
+            operation.progress_interval = std::chrono::milliseconds(static_cast<int64_t>(interval));
+        }
+
+        Protected<typename T::GlobalContext> protected_ctx(Context<T>::get_global_context(ctx));
+        util::Optional<EventLoopDispatcher<FileOperation::ProgressHandler>> progress_handler;
+        if (!Value::is_undefined(ctx, progress_value) && !Value::is_null(ctx, progress_value)) {
+            Protected<FunctionType> protected_progress(ctx, Value::validated_to_function(ctx, progress_value, "onProgress"));
+            progress_handler = EventLoopDispatcher<FileOperation::ProgressHandler>([=](uint64_t transferred_bytes, uint64_t transferable_bytes) {
+                HANDLESCOPE
+                ValueType callback_arguments[2];
+                callback_arguments[0] = Value::from_number(protected_ctx, transferred_bytes);
+                callback_arguments[1] = Value::from_number(protected_ctx, transferable_bytes);
+                Function<T>::callback(protected_ctx, protected_progress, typename T::Object(), 2, callback_arguments);
+            }, EventLoopDispatcher<FileOperation::ProgressHandler>::latest());
+        }
+
+        Protected<FunctionType> protected_completion(ctx, completion_function);
+        EventLoopDispatcher<FileOperation::CompletionHandler> completion_handler([=](std::string error, bool result) {
+            HANDLESCOPE
+            ValueType callback_arguments[2];
+            if (error.empty()) {
+                callback_arguments[0] = Value::from_null(protected_ctx);
+            }
+            else {
+                ObjectType error_object = Object::create_empty(protected_ctx);
+                Object::set_property(protected_ctx, error_object, "message", Value::from_string(protected_ctx, error));
+                callback_arguments[0] = error_object;
+            }
+            callback_arguments[1] = Value::from_boolean(protected_ctx, result);
+            Function<T>::callback(protected_ctx, protected_completion, typename T::Object(), 2, callback_arguments);
+        });
+
+        auto id = FileOperation::start(std::move(operation), std::move(progress_handler), std::move(completion_handler));
+        return_value.set((double)id);
+    }
+
     static std::string validated_notification_name(ContextType ctx, const ValueType &value) {
         std::string name = Value::validated_to_string(ctx, value, "notification name");
         if (name == "change" || name == "schema") {
@@ -384,12 +503,14 @@ inline typename T::Function RealmClass<T>::create_constructor(ContextType ctx) {
     FunctionType collection_constructor = ObjectWrap<T, CollectionClass<T>>::create_constructor(ctx);
     FunctionType list_constructor = ObjectWrap<T, ListClass<T>>::create_constructor(ctx);
     FunctionType results_constructor = ObjectWrap<T, ResultsClass<T>>::create_constructor(ctx);
+    FunctionType results_window_constructor = ObjectWrap<T, ResultsWindowClass<T>>::create_constructor(ctx);
     FunctionType realm_object_constructor = ObjectWrap<T, RealmObjectClass<T>>::create_constructor(ctx);
 
     PropertyAttributes attributes = ReadOnly | DontEnum | DontDelete;
     Object::set_property(ctx, realm_constructor, "Collection", collection_constructor, attributes);
     Object::set_property(ctx, realm_constructor, "List", list_constructor, attributes);
     Object::set_property(ctx, realm_constructor, "Results", results_constructor, attributes);
+    Object::set_property(ctx, results_constructor, "Window", results_window_constructor, attributes);
     Object::set_property(ctx, realm_constructor, "Object", realm_object_constructor, attributes);
 
 #if REALM_ENABLE_SYNC
@@ -624,6 +745,7 @@ SharedRealm RealmClass<T>::create_shared_realm(ContextType ctx, realm::Realm::Co
     RealmDelegate<T> *js_binding_context = dynamic_cast<RealmDelegate<T> *>(realm->m_binding_context.get());
     REALM_ASSERT(js_binding_context);
     REALM_ASSERT(js_binding_context->m_context == global_context);
+    register_realm(*config.execution_context, realm);
 
     // If a new schema was provided, then use its defaults and constructors.
     if (schema_updated) {
@@ -661,6 +783,36 @@ void RealmClass<T>::clear_test_state(ContextType ctx, ObjectType this_object, Ar
     js::clear_test_state();
 }
 
+template<typename T>
+void RealmClass<T>::set_notification_budget(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
+    args.validate_maximum(1);
+
+    double budget = Value::validated_to_number(ctx, args[0], "budgetMs");
+    if (!(budget >= 0)) {
+        throw std::invalid_argument("'budgetMs' must not be negative.");
+    }
+    NotificationScheduler::budget() = std::chrono::microseconds(static_cast<int64_t>(budget * 1000));
+}
+
+template<typename T>
+void RealmClass<T>::notification_metrics(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
+    args.validate_maximum(0);
+
+    auto to_milliseconds = [](NotificationScheduler::Clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    };
+
+    auto& metrics = NotificationScheduler::metrics();
+    ObjectType object = Object::create_empty(ctx);
+    Object::set_property(ctx, object, "ticks", Value::from_number(ctx, metrics.ticks));
+    Object::set_property(ctx, object, "delivered", Value::from_number(ctx, metrics.delivered));
+    Object::set_property(ctx, object, "deferred", Value::from_number(ctx, metrics.deferred));
+    Object::set_property(ctx, object, "lastTickMs", Value::from_number(ctx, to_milliseconds(metrics.last_tick)));
+    Object::set_property(ctx, object, "maxTickMs", Value::from_number(ctx, to_milliseconds(metrics.max_tick)));
+    Object::set_property(ctx, object, "totalTickMs", Value::from_number(ctx, to_milliseconds(metrics.total)));
+    return_value.set(object);
+}
+
 template<typename T>
 void RealmClass<T>::copy_bundled_realm_files(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
     args.validate_maximum(0);
@@ -698,6 +850,54 @@ void RealmClass<T>::delete_file(ContextType ctx, ObjectType this_object, Argumen
 
 }
 
+template<typename T>
+void RealmClass<T>::compact_async(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
+    args.validate_count(4);
+
+    ObjectType object = Value::validated_to_object(ctx, args[0], "config");
+    realm::Realm::Config config;
+
+    static const String path_string = "path";
+    ValueType path_value = Object::get_property(ctx, object, path_string);
+    if (!Value::is_undefined(ctx, path_value)) {
+        config.path = Value::validated_to_string(ctx, path_value, "path");
+    }
+    else {
+        config.path = js::default_path();
+    }
+    config.path = normalize_realm_path(config.path);
+
+    static const String encryption_key_string = "encryptionKey";
+    ValueType encryption_key_value = Object::get_property(ctx, object, encryption_key_string);
+    if (!Value::is_undefined(ctx, encryption_key_value)) {
+        auto encryption_key = Value::validated_to_binary(ctx, encryption_key_value, "encryptionKey");
+        config.encryption_key.assign(encryption_key.data(), encryption_key.data() + encryption_key.size());
+    }
+    config = config_for_background_thread(std::move(config));
+
+    // Core writes the compacted file next to the original before replacing it.
+    FileOperation::Config operation;
+    operation.output_path = config.path + ".tmp_compaction_space";
+    operation.result_path = config.path;
+    operation.expected_size = FileOperation::file_size(config.path);
+    operation.work = [config] {
+        auto realm = realm::Realm::get_shared_realm(config);
+        bool compacted = realm->compact();
+        realm->close();
+        return compacted;
+    };
+
+    start_file_operation(ctx, std::move(operation), args[1], args[2], args[3], return_value);
+}
+
+template<typename T>
+void RealmClass<T>::cancel_file_operation(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
+    args.validate_count(1);
+
+    auto id = Value::validated_to_number(ctx, args[0], "operation");
+    return_value.set(FileOperation::cancel(static_cast<FileOperation::OperationID>(id)));
+}
+
 template<typename T>
 void RealmClass<T>::delete_model(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
     args.validate_maximum(1);
@@ -944,6 +1144,89 @@ void RealmClass<T>::delete_one(ContextType ctx, ObjectType this_object, Argument
     }
 }
 
+template<typename T>
+void RealmClass<T>::create_thread_safe_reference(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
+    args.validate_count(1);
+
+    SharedRealm realm = *get_internal<T, RealmClass<T>>(this_object);
+    realm->verify_open();
+
+    ObjectType arg = Value::validated_to_object(ctx, args[0], "object");
+
+    StoredThreadSafeReference stored;
+    stored.path = realm->config().path;
+    if (Object::template is_instance<RealmObjectClass<T>>(ctx, arg)) {
+        auto object = get_internal<T, RealmObjectClass<T>>(arg);
+        if (!object->is_valid()) {
+            throw std::runtime_error("Object is invalid. Either it has been previously deleted or the Realm it belongs to has been closed.");
+        }
+        stored.type = "object";
+        stored.reference.reset(new ThreadSafeReference<realm::Object>(realm->obtain_thread_safe_reference(static_cast<realm::Object&>(*object))));
+    }
+    else if (Object::template is_instance<ResultsClass<T>>(ctx, arg)) {
+        auto results = get_internal<T, ResultsClass<T>>(arg);
+        stored.type = "results";
+        stored.reference.reset(new ThreadSafeReference<realm::Results>(realm->obtain_thread_safe_reference(static_cast<realm::Results&>(*results))));
+    }
+    else if (Object::template is_instance<ListClass<T>>(ctx, arg)) {
+        auto list = get_internal<T, ListClass<T>>(arg);
+        stored.type = "list";
+        stored.reference.reset(new ThreadSafeReference<realm::List>(realm->obtain_thread_safe_reference(static_cast<realm::List&>(*list))));
+    }
+    else {
+        throw std::runtime_error("Argument to 'createThreadSafeReference' must be a Realm object or a collection of Realm objects.");
+    }
+
+    std::string type = stored.type;
+    auto id = store_thread_safe_reference(std::move(stored));
+
+    static const String id_string = "_threadSafeReference";
+    static const String type_string = "type";
+    static const String path_string = "path";
+    ObjectType token = Object::create_empty(ctx);
+    Object::set_property(ctx, token, id_string, Value::from_number(ctx, (double)id));
+    Object::set_property(ctx, token, type_string, Value::from_string(ctx, type));
+    Object::set_property(ctx, token, path_string, Value::from_string(ctx, realm->config().path));
+    return_value.set(token);
+}
+
+template<typename T>
+void RealmClass<T>::resolve_thread_safe_reference(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
+    args.validate_count(1);
+
+    SharedRealm realm = *get_internal<T, RealmClass<T>>(this_object);
+    realm->verify_open();
+
+    static const String id_string = "_threadSafeReference";
+    ObjectType token = Value::validated_to_object(ctx, args[0], "reference");
+    auto id = Object::validated_get_number(ctx, token, id_string, "thread-safe reference");
+
+    StoredThreadSafeReference stored = take_thread_safe_reference(static_cast<uint64_t>(id), realm->config().path);
+
+    if (stored.type == "object") {
+        auto& reference = static_cast<ThreadSafeReference<realm::Object>&>(*stored.reference);
+        return_value.set(RealmObjectClass<T>::create_instance(ctx, realm->resolve_thread_safe_reference(std::move(reference))));
+    }
+    else if (stored.type == "results") {
+        auto& reference = static_cast<ThreadSafeReference<realm::Results>&>(*stored.reference);
+        return_value.set(ResultsClass<T>::create_instance(ctx, realm->resolve_thread_safe_reference(std::move(reference))));
+    }
+    else {
+        auto& reference = static_cast<ThreadSafeReference<realm::List>&>(*stored.reference);
+        return_value.set(ListClass<T>::create_instance(ctx, realm->resolve_thread_safe_reference(std::move(reference))));
+    }
+}
+
+template<typename T>
+void RealmClass<T>::release_thread_safe_reference(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
+    args.validate_count(1);
+
+    static const String id_string = "_threadSafeReference";
+    ObjectType token = Value::validated_to_object(ctx, args[0], "reference");
+    auto id = Object::validated_get_number(ctx, token, id_string, "thread-safe reference");
+    return_value.set(realm::js::release_thread_safe_reference(static_cast<uint64_t>(id)));
+}
+
 template<typename T>
 void RealmClass<T>::delete_all(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
     args.validate_maximum(0);
@@ -1012,7 +1295,7 @@ void RealmClass<T>::cancel_transaction(ContextType ctx, ObjectType this_object,
 
 template<typename T>
 void RealmClass<T>::add_listener(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
-    args.validate_maximum(2);
+    args.validate_maximum(3);
 
     auto name = validated_notification_name(ctx, args[0]);
     auto callback = Value::validated_to_function(ctx, args[1]);
@@ -1020,7 +1303,15 @@ void RealmClass<T>::add_listener(ContextType ctx, ObjectType this_object, Argume
     SharedRealm realm = *get_internal<T, RealmClass<T>>(this_object);
     realm->verify_open();
     if (name == "change") {
-        get_delegate<T>(realm.get())->add_notification(callback);
+        std::chrono::milliseconds throttle{0}, debounce{0};
+        if (!Value::is_undefined(ctx, args[2])) {
+            static const String throttle_string = "throttleMs";
+            static const String debounce_string = "debounceMs";
+            auto options = Value::validated_to_object(ctx, args[2], "options");
+            throttle = CollectionClass<T>::validated_get_interval(ctx, options, throttle_string);
+            debounce = CollectionClass<T>::validated_get_interval(ctx, options, debounce_string);
+        }
+        get_delegate<T>(realm.get())->add_notification(callback, throttle, debounce);
     }
     else {
         get_delegate<T>(realm.get())->add_schema_notification(callback);
@@ -1062,6 +1353,40 @@ void RealmClass<T>::remove_all_listeners(ContextType ctx, ObjectType this_object
     }
 }
 
+template<typename T>
+void RealmClass<T>::add_batch_listener(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
+    args.validate_count(2);
+
+    auto callback = Value::validated_to_function(ctx, args[0]);
+    auto targets = Value::validated_to_array(ctx, args[1], "objects");
+
+    SharedRealm realm = *get_internal<T, RealmClass<T>>(this_object);
+    realm->verify_open();
+    auto delegate = get_delegate<T>(realm.get());
+    auto listener = delegate->add_batch_notification(ctx, callback);
+    try {
+        uint32_t count = Object::validated_get_length(ctx, targets);
+        for (uint32_t i = 0; i < count; i++) {
+            listener->observe(ctx, Object::validated_get_object(ctx, targets, i));
+        }
+    }
+    catch (...) {
+        delegate->remove_batch_notification(callback);
+        throw;
+    }
+}
+
+template<typename T>
+void RealmClass<T>::remove_batch_listener(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
+    args.validate_count(1);
+
+    auto callback = Value::validated_to_function(ctx, args[0]);
+
+    SharedRealm realm = *get_internal<T, RealmClass<T>>(this_object);
+    realm->verify_open();
+    get_delegate<T>(realm.get())->remove_batch_notification(callback);
+}
+
 template<typename T>
 void RealmClass<T>::close(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
     args.validate_maximum(0);
@@ -1112,6 +1437,44 @@ void RealmClass<T>::writeCopyTo(ContextType ctx, ObjectType this_object, Argumen
     realm->write_copy(path, key);
 }
 
+template<typename T>
+void RealmClass<T>::write_copy_to_async(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
+    args.validate_count(5);
+
+    SharedRealm realm = *get_internal<T, RealmClass<T>>(this_object);
+    realm->verify_open();
+
+    std::string path = Value::validated_to_string(ctx, args[0], "path");
+    std::vector<char> key;
+    if (!Value::is_undefined(ctx, args[1]) && !Value::is_null(ctx, args[1])) {
+        if (!Value::is_binary(ctx, args[1])) {
+            throw std::runtime_error("Encryption key for 'writeCopyTo' must be a Binary.");
+        }
+        auto key_data = Value::to_binary(ctx, args[1]);
+        key.assign(key_data.data(), key_data.data() + key_data.size());
+    }
+
+    // The copy is made from the latest committed version, as a background instance
+    // cannot see the state of a write transaction in progress on this thread.
+    auto config = config_for_background_thread(realm->config());
+
+    FileOperation::Config operation;
+    operation.output_path = path;
+    operation.result_path = path;
+    operation.expected_size = FileOperation::file_size(config.path);
+    operation.work = [config, path, key] {
+        auto copy_realm = realm::Realm::get_shared_realm(config);
+        copy_realm->write_copy(path, key.empty() ? BinaryData() : BinaryData(key.data(), key.size()));
+        copy_realm->close();
+        return true;
+    };
+    operation.rollback = [path] {
+        util::File::try_remove(path);
+    };
+
+    start_file_operation(ctx, std::move(operation), args[2], args[3], args[4], return_value);
+}
+
 template<typename T>
 void RealmClass<T>::object_for_object_id(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue& return_value) {
     args.validate_count(2);
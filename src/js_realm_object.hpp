@@ -19,9 +19,16 @@
 #pragma once
 
 #include "object_accessor.hpp"
+#include "object_schema.hpp"
 #include "object_store.hpp"
+#include "property.hpp"
+#include "shared_realm.hpp"
+
+#include "listener_registry.hpp"
+#include "notification_scheduler.hpp"
 
 #include "js_class.hpp"
+#include "js_collection.hpp"
 #include "js_types.hpp"
 #include "js_util.hpp"
 #include "js_schema.hpp"
@@ -31,8 +38,129 @@ namespace js {
 
 template<typename> class NativeAccessor;
 
+// Reduces object change sets to the changes of the properties named by a list of key paths,
+// e.g. `['status', 'owner.name']`. Collection notifiers do not say which columns changed, so
+// collection listeners cannot be filtered this way.
+class KeyPathFilter {
+public:
+    KeyPathFilter() = default;
+    KeyPathFilter(const SharedRealm& realm, const ObjectSchema& object_schema, const std::vector<std::string>& key_paths);
+
+    explicit operator bool() const { return m_enabled; }
+
+    // Returns false if `change_set` does not affect any of the key paths. Otherwise removes the
+    // modifications which do not affect them.
+    bool apply(CollectionChangeSet& change_set) const;
+
+private:
+    bool m_enabled = false;
+    std::vector<size_t> m_columns;
+    // Set if a key path goes through a link. Changes to linked objects are only reported per row,
+    // so those rows are always kept.
+    bool m_deep = false;
+};
+
+inline KeyPathFilter::KeyPathFilter(const SharedRealm& realm, const ObjectSchema& object_schema, const std::vector<std::string>& key_paths)
+: m_enabled(!key_paths.empty())
+{
+    for (auto& key_path : key_paths) {
+        const ObjectSchema* schema = &object_schema;
+        size_t start = 0;
+        bool first = true;
+        while (true) {
+            size_t end = key_path.find('.', start);
+            std::string name = key_path.substr(start, end == std::string::npos ? std::string::npos : end - start);
+            if (!schema) {
+                throw std::invalid_argument(util::format("Key path '%1' continues past the non-link property before '%2'.", key_path, name));
+            }
+            const Property* property = schema->property_for_name(name);
+            if (!property) {
+                throw std::invalid_argument(util::format("Property '%1' of key path '%2' does not exist on object '%3'.",
+                                                         name, key_path, schema->name));
+            }
+            if (first) {
+                if (property->type == PropertyType::LinkingObjects) {
+                    m_deep = true;
+                }
+                else {
+                    m_columns.push_back(property->table_column);
+                }
+                first = false;
+            }
+
+            if (end == std::string::npos) {
+                break;
+            }
+            m_deep = true;
+            auto target = (property->type & ~PropertyType::Flags) == PropertyType::Object || property->type == PropertyType::LinkingObjects
+                        ? realm->schema().find(property->object_type) : realm->schema().end();
+            schema = target == realm->schema().end() ? nullptr : &*target;
+            start = end + 1;
+        }
+    }
+}
+
+inline bool KeyPathFilter::apply(CollectionChangeSet& change_set) const
+{
+    // The initial notification is always delivered.
+    if (!m_enabled || change_set.empty()) {
+        return true;
+    }
+
+    IndexSet modifications;
+    if (change_set.columns.empty()) {
+        // The notifier did not say which columns changed, so every modification may be relevant.
+        modifications = change_set.modifications;
+    }
+    else {
+        for (size_t column : m_columns) {
+            if (column < change_set.columns.size()) {
+                modifications.add(change_set.columns[column]);
+            }
+        }
+        if (m_deep) {
+            IndexSet rows = change_set.modifications;
+            for (auto& column : change_set.columns) {
+                rows.remove(column);
+            }
+            modifications.add(rows);
+        }
+    }
+
+    bool structural = !change_set.insertions.empty() || !change_set.deletions.empty() || !change_set.moves.empty();
+    if (modifications.empty() && !structural) {
+        return false;
+    }
+    if (modifications.count() == change_set.modifications.count()) {
+        return true;
+    }
+
+    IndexSet modifications_new;
+    for (auto index : modifications.as_indexes()) {
+        auto move = std::find_if(change_set.moves.begin(), change_set.moves.end(), [&](auto& move) { return move.from == index; });
+        if (move != change_set.moves.end()) {
+            modifications_new.add(move->to);
+        }
+        else if (!change_set.deletions.contains(index)) {
+            modifications_new.add(change_set.insertions.shift(change_set.deletions.unshift(index)));
+        }
+    }
+    change_set.modifications = std::move(modifications);
+    change_set.modifications_new = std::move(modifications_new);
+    return true;
+}
+
 template<typename T>
-struct RealmObjectClass : ClassDefinition<T, realm::Object> {
+class RealmObject : public realm::Object {
+  public:
+    RealmObject(realm::Object const& o) : realm::Object(o) {}
+    RealmObject(realm::Object&& o) : realm::Object(std::move(o)) {}
+
+    NotificationTokens<T, NotificationToken> m_notification_tokens;
+};
+
+template<typename T>
+struct RealmObjectClass : ClassDefinition<T, realm::js::RealmObject<T>> {
     using ContextType = typename T::Context;
     using FunctionType = typename T::Function;
     using ObjectType = typename T::Object;
@@ -57,6 +185,11 @@ struct RealmObjectClass : ClassDefinition<T, realm::Object> {
     static void get_object_id(ContextType, ObjectType, Arguments, ReturnValue &);
     static void is_same_object(ContextType, ObjectType, Arguments, ReturnValue &);
     static void set_link(ContextType, ObjectType, Arguments, ReturnValue &);
+    static void add_listener(ContextType, ObjectType, Arguments, ReturnValue &);
+    static void remove_listener(ContextType, ObjectType, Arguments, ReturnValue &);
+    static void remove_all_listeners(ContextType, ObjectType, Arguments, ReturnValue &);
+
+    static ValueType create_object_change_set(ContextType, const realm::Object &, const CollectionChangeSet &);
 
     const std::string name = "RealmObject";
 
@@ -74,6 +207,9 @@ struct RealmObjectClass : ClassDefinition<T, realm::Object> {
         {"_objectId", wrap<get_object_id>},
         {"_isSameObject", wrap<is_same_object>},
         {"_setLink", wrap<set_link>},
+        {"addListener", wrap<add_listener>},
+        {"removeListener", wrap<remove_listener>},
+        {"removeAllListeners", wrap<remove_all_listeners>},
     };
 };
 
@@ -94,7 +230,7 @@ typename T::Object RealmObjectClass<T>::create_instance(ContextType ctx, realm::
 
     auto delegate = get_delegate<T>(realm_object.realm().get());
     auto name = realm_object.get_object_schema().name;
-    auto object = create_object<T, RealmObjectClass<T>>(ctx, new realm::Object(std::move(realm_object)));
+    auto object = create_object<T, RealmObjectClass<T>>(ctx, new RealmObject<T>(std::move(realm_object)));
 
     if (!delegate || !delegate->m_constructors.count(name)) {
         return object;
@@ -189,6 +325,77 @@ void RealmObjectClass<T>::set_link(ContextType ctx, ObjectType object, Arguments
     }
 }
 
+template<typename T>
+typename T::Value RealmObjectClass<T>::create_object_change_set(ContextType ctx, const realm::Object &realm_object, const CollectionChangeSet &change_set) {
+    ObjectType object = Object::create_empty(ctx);
+
+    // The object notifier reports a change set for a collection holding just this object.
+    bool deleted = !change_set.deletions.empty();
+    Object::set_property(ctx, object, "deleted", Value::from_boolean(ctx, deleted));
+
+    std::vector<ValueType> changed_properties;
+    if (!deleted) {
+        for (auto &prop : realm_object.get_object_schema().persisted_properties) {
+            if (prop.table_column < change_set.columns.size() && !change_set.columns[prop.table_column].empty()) {
+                changed_properties.push_back(Value::from_string(ctx, prop.name));
+            }
+        }
+    }
+    Object::set_property(ctx, object, "changedProperties", Object::create_array(ctx, changed_properties));
+
+    return object;
+}
+
+template<typename T>
+void RealmObjectClass<T>::add_listener(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
+    args.validate_maximum(2);
+
+    auto realm_object = get_internal<T, RealmObjectClass<T>>(this_object);
+    auto callback = Value::validated_to_function(ctx, args[0]);
+    auto options = CollectionClass<T>::validated_to_listener_options(ctx, args[1]);
+    auto listener_callback = realm_object->m_notification_tokens.make_callback(ctx, callback, this_object, options.weak);
+    Protected<typename T::GlobalContext> protected_ctx(Context<T>::get_global_context(ctx));
+
+    KeyPathFilter filter(realm_object->realm(), realm_object->get_object_schema(), options.key_paths);
+    realm::Object observed = *realm_object;
+
+    auto listener = NotificationScheduler::make_listener(options.priority, [=](CollectionChangeSet const& change_set) {
+        HANDLESCOPE
+        if (!listener_callback.expired()) {
+            listener_callback.call(protected_ctx, create_object_change_set(protected_ctx, observed, change_set));
+        }
+    });
+
+    auto token = realm_object->add_notification_callback([=](CollectionChangeSet const& changes, std::exception_ptr exception) {
+        util::Optional<CollectionChangeSet> filtered;
+        if (filter) {
+            filtered = changes;
+            if (!filter.apply(*filtered)) {
+                return;
+            }
+        }
+        listener->deliver(filtered ? *filtered : changes);
+    });
+    realm_object->m_notification_tokens.add(listener_callback, std::move(token));
+}
+
+template<typename T>
+void RealmObjectClass<T>::remove_listener(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
+    args.validate_maximum(1);
+
+    auto callback = Value::validated_to_function(ctx, args[0]);
+    auto realm_object = get_internal<T, RealmObjectClass<T>>(this_object);
+    realm_object->m_notification_tokens.remove(callback);
+}
+
+template<typename T>
+void RealmObjectClass<T>::remove_all_listeners(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
+    args.validate_maximum(0);
+
+    auto realm_object = get_internal<T, RealmObjectClass<T>>(this_object);
+    realm_object->m_notification_tokens.clear();
+}
+
 template<typename T>
 std::vector<String<T>> RealmObjectClass<T>::get_property_names(ContextType ctx, ObjectType object) {
     auto realm_object = get_internal<T, RealmObjectClass<T>>(object);
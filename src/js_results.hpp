@@ -20,7 +20,11 @@
 
 #include "js_collection.hpp"
 #include "js_realm_object.hpp"
+#include "js_results_window.hpp"
 #include "js_util.hpp"
+#include "listener_registry.hpp"
+#include "notification_scheduler.hpp"
+#include "notification_throttle.hpp"
 
 #include "results.hpp"
 #include "list.hpp"
@@ -55,7 +59,7 @@ class Results : public realm::Results {
 
     using realm::Results::Results;
 
-    std::vector<std::pair<Protected<typename T::Function>, NotificationToken>> m_notification_tokens;
+    NotificationTokens<T, NotificationToken> m_notification_tokens;
 };
 
 template<typename T>
@@ -84,6 +88,7 @@ struct ResultsClass : ClassDefinition<T, realm::js::Results<T>, CollectionClass<
     static void get_index(ContextType, ObjectType, uint32_t, ReturnValue &);
 
     static void snapshot(ContextType, ObjectType, Arguments, ReturnValue &);
+    static void window(ContextType, ObjectType, Arguments, ReturnValue &);
     static void filtered(ContextType, ObjectType, Arguments, ReturnValue &);
     static void sorted(ContextType, ObjectType, Arguments, ReturnValue &);
     static void is_valid(ContextType, ObjectType, Arguments, ReturnValue &);
@@ -113,6 +118,7 @@ struct ResultsClass : ClassDefinition<T, realm::js::Results<T>, CollectionClass<
 
     MethodMap<T> const methods = {
         {"snapshot", wrap<snapshot>},
+        {"window", wrap<window>},
         {"filtered", wrap<filtered>},
         {"sorted", wrap<sorted>},
         {"isValid", wrap<is_valid>},
@@ -124,6 +130,7 @@ struct ResultsClass : ClassDefinition<T, realm::js::Results<T>, CollectionClass<
         {"max", wrap<compute_aggregate_on_collection<ResultsClass<T>, AggregateFunc::Max>>},
         {"sum", wrap<compute_aggregate_on_collection<ResultsClass<T>, AggregateFunc::Sum>>},
         {"avg", wrap<compute_aggregate_on_collection<ResultsClass<T>, AggregateFunc::Avg>>},
+        {"count", wrap<compute_count_on_collection<ResultsClass<T>>>},
         {"addListener", wrap<add_listener>},
         {"removeListener", wrap<remove_listener>},
         {"removeAllListeners", wrap<remove_all_listeners>},
@@ -268,6 +275,16 @@ void ResultsClass<T>::snapshot(ContextType ctx, ObjectType this_object, Argument
     return_value.set(ResultsClass<T>::create_instance(ctx, results->snapshot()));
 }
 
+template<typename T>
+void ResultsClass<T>::window(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
+    args.validate_count(2);
+
+    auto results = get_internal<T, ResultsClass<T>>(this_object);
+    size_t start = ResultsWindowClass<T>::validated_to_size(ctx, args[0], "start");
+    size_t count = ResultsWindowClass<T>::validated_to_size(ctx, args[1], "count");
+    return_value.set(ResultsWindowClass<T>::create_instance(ctx, *results, start, count));
+}
+
 template<typename T>
 void ResultsClass<T>::filtered(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
     auto results = get_internal<T, ResultsClass<T>>(this_object);
@@ -376,22 +393,44 @@ void ResultsClass<T>::index_of(ContextType ctx, ObjectType this_object,
 template<typename T>
 template<typename U>
 void ResultsClass<T>::add_listener(ContextType ctx, U& collection, ObjectType this_object, Arguments args) {
-    args.validate_maximum(1);
+    args.validate_maximum(2);
 
     auto callback = Value::validated_to_function(ctx, args[0]);
-    Protected<FunctionType> protected_callback(ctx, callback);
-    Protected<ObjectType> protected_this(ctx, this_object);
+    auto options = CollectionClass<T>::validated_to_listener_options(ctx, args[1]);
+    auto listener_callback = collection.m_notification_tokens.make_callback(ctx, callback, this_object, options.weak);
     Protected<typename T::GlobalContext> protected_ctx(Context<T>::get_global_context(ctx));
 
+    // Collection change sets only list the modified rows, not the modified columns, so they cannot
+    // be filtered by key path.
+    if (!options.key_paths.empty()) {
+        throw std::invalid_argument("'keyPaths' is only supported by object listeners.");
+    }
+
+    auto deliver = [=](CollectionChangeSet const& change_set) {
+        HANDLESCOPE
+        if (!listener_callback.expired()) {
+            listener_callback.call(protected_ctx, CollectionClass<T>::create_collection_change_set(protected_ctx, change_set, options.index_format));
+        }
+    };
+    auto listener = NotificationScheduler::make_listener(options.priority, deliver);
+
+    std::shared_ptr<NotificationThrottle> throttle;
+    if (options.throttle.count() > 0 || options.debounce.count() > 0) {
+        throttle = NotificationThrottle::create(options.throttle, options.debounce, [=](CollectionChangeSet const& change_set) {
+            listener->deliver(change_set);
+        });
+    }
+
     auto token = collection.add_notification_callback([=](CollectionChangeSet const& change_set, std::exception_ptr exception) {
-            HANDLESCOPE
-            ValueType arguments[] {
-                static_cast<ObjectType>(protected_this),
-                CollectionClass<T>::create_collection_change_set(protected_ctx, change_set)
-            };
-            Function<T>::callback(protected_ctx, protected_callback, protected_this, 2, arguments);
+            // The initial notification is never held back.
+            if (throttle && !change_set.empty()) {
+                throttle->add(change_set);
+            }
+            else {
+                listener->deliver(change_set);
+            }
         });
-    collection.m_notification_tokens.emplace_back(protected_callback, std::move(token));
+    collection.m_notification_tokens.add(listener_callback, std::move(token));
 }
 
 template<typename T>
@@ -406,13 +445,7 @@ void ResultsClass<T>::remove_listener(ContextType ctx, U& collection, ObjectType
     args.validate_maximum(1);
 
     auto callback = Value::validated_to_function(ctx, args[0]);
-    auto protected_function = Protected<FunctionType>(ctx, callback);
-
-    auto& tokens = collection.m_notification_tokens;
-    auto compare = [&](auto&& token) {
-        return typename Protected<FunctionType>::Comparator()(token.first, protected_function);
-    };
-    tokens.erase(std::remove_if(tokens.begin(), tokens.end(), compare), tokens.end());
+    collection.m_notification_tokens.remove(callback);
 }
 
 template<typename T>
@@ -0,0 +1,264 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2018 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+#include "js_class.hpp"
+#include "js_collection.hpp"
+#include "js_types.hpp"
+#include "listener_registry.hpp"
+#include "notification_scheduler.hpp"
+
+#include "collection_notifications.hpp"
+#include "results.hpp"
+
+namespace realm {
+namespace js {
+
+template<typename>
+class NativeAccessor;
+
+// Translates the changes of a whole collection into changes of the rows at [start, start + count)
+// before and after the change, which has `new_size` rows afterwards. Rows which are shifted into the
+// window by changes elsewhere are reported as inserted, and rows shifted out of it as deleted.
+inline CollectionChangeSet window_change_set(CollectionChangeSet const& changes, size_t new_size, size_t start, size_t count) {
+    CollectionChangeSet window;
+    size_t old_size = new_size + changes.deletions.count() - changes.insertions.count();
+    // Written so that `start + count` cannot overflow.
+    size_t old_end = start < old_size ? start + std::min(count, old_size - start) : start;
+    size_t new_end = start < new_size ? start + std::min(count, new_size - start) : start;
+
+    for (size_t i = start; i < old_end; ++i) {
+        bool retained = false;
+        if (!changes.deletions.contains(i)) {
+            size_t new_index = changes.insertions.shift(changes.deletions.unshift(i));
+            retained = new_index >= start && new_index < new_end;
+        }
+        if (!retained) {
+            window.deletions.add(i - start);
+        }
+        else if (changes.modifications.contains(i)) {
+            window.modifications.add(i - start);
+        }
+    }
+
+    for (size_t i = start; i < new_end; ++i) {
+        bool retained = false;
+        if (!changes.insertions.contains(i)) {
+            size_t old_index = changes.deletions.shift(changes.insertions.unshift(i));
+            retained = old_index >= start && old_index < old_end;
+        }
+        if (!retained) {
+            window.insertions.add(i - start);
+        }
+        else if (changes.modifications_new.contains(i)) {
+            window.modifications_new.add(i - start);
+        }
+    }
+    return window;
+}
+
+// A view of the rows [start, start + count) of live results. Only the rows in the window are read,
+// and its listeners are only called when the rows in the window change.
+template<typename T>
+class ResultsWindow {
+  public:
+    struct State {
+        realm::Results results;
+        size_t start;
+        size_t count;
+
+        size_t size() {
+            size_t total = results.size();
+            return start < total ? std::min(count, total - start) : 0;
+        }
+    };
+
+    ResultsWindow(realm::Results results, size_t start, size_t count)
+    : m_state(std::make_shared<State>(State{std::move(results), start, count})) {}
+
+    // Shared with the notification callbacks, which may outlive the window.
+    const std::shared_ptr<State> m_state;
+    NotificationTokens<T, NotificationToken> m_notification_tokens;
+};
+
+template<typename T>
+struct ResultsWindowClass : ClassDefinition<T, ResultsWindow<T>> {
+    using ContextType = typename T::Context;
+    using ObjectType = typename T::Object;
+    using ValueType = typename T::Value;
+    using FunctionType = typename T::Function;
+    using Object = js::Object<T>;
+    using Value = js::Value<T>;
+    using ReturnValue = js::ReturnValue<T>;
+    using Arguments = js::Arguments<T>;
+
+    static ObjectType create_instance(ContextType, realm::Results, size_t start, size_t count);
+
+    // Returns `value` as a row index or number of rows, which is at most UINT32_MAX.
+    static size_t validated_to_size(ContextType, const ValueType &value, const char *name);
+
+    static void get_length(ContextType, ObjectType, ReturnValue &);
+    static void get_start(ContextType, ObjectType, ReturnValue &);
+    static void get_count(ContextType, ObjectType, ReturnValue &);
+    static void get_index(ContextType, ObjectType, uint32_t, ReturnValue &);
+
+    static void move(ContextType, ObjectType, Arguments, ReturnValue &);
+    static void add_listener(ContextType, ObjectType, Arguments, ReturnValue &);
+    static void remove_listener(ContextType, ObjectType, Arguments, ReturnValue &);
+    static void remove_all_listeners(ContextType, ObjectType, Arguments, ReturnValue &);
+
+    std::string const name = "ResultsWindow";
+
+    MethodMap<T> const methods = {
+        {"move", wrap<move>},
+        {"addListener", wrap<add_listener>},
+        {"removeListener", wrap<remove_listener>},
+        {"removeAllListeners", wrap<remove_all_listeners>},
+    };
+
+    PropertyMap<T> const properties = {
+        {"length", {wrap<get_length>, nullptr}},
+        {"start", {wrap<get_start>, nullptr}},
+        {"count", {wrap<get_count>, nullptr}},
+    };
+
+    IndexPropertyType<T> const index_accessor = {wrap<get_index>, nullptr};
+};
+
+template<typename T>
+typename T::Object ResultsWindowClass<T>::create_instance(ContextType ctx, realm::Results results, size_t start, size_t count) {
+    return create_object<T, ResultsWindowClass<T>>(ctx, new ResultsWindow<T>(std::move(results), start, count));
+}
+
+template<typename T>
+size_t ResultsWindowClass<T>::validated_to_size(ContextType ctx, const ValueType &value, const char *name) {
+    double number = Value::validated_to_number(ctx, value, name);
+    if (!(number >= 0) || std::floor(number) != number) {
+        throw std::invalid_argument(util::format("'%1' must be a non-negative integer.", name));
+    }
+    // Indexes are reported to JS as 32-bit numbers, and larger values would not fit a size_t everywhere.
+    if (number > std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument(util::format("'%1' must not be greater than %2.", name, std::numeric_limits<uint32_t>::max()));
+    }
+    return static_cast<size_t>(number);
+}
+
+template<typename T>
+void ResultsWindowClass<T>::get_length(ContextType ctx, ObjectType object, ReturnValue &return_value) {
+    auto window = get_internal<T, ResultsWindowClass<T>>(object);
+    return_value.set((uint32_t)window->m_state->size());
+}
+
+template<typename T>
+void ResultsWindowClass<T>::get_start(ContextType ctx, ObjectType object, ReturnValue &return_value) {
+    auto window = get_internal<T, ResultsWindowClass<T>>(object);
+    return_value.set((uint32_t)window->m_state->start);
+}
+
+template<typename T>
+void ResultsWindowClass<T>::get_count(ContextType ctx, ObjectType object, ReturnValue &return_value) {
+    auto window = get_internal<T, ResultsWindowClass<T>>(object);
+    return_value.set((uint32_t)window->m_state->count);
+}
+
+template<typename T>
+void ResultsWindowClass<T>::get_index(ContextType ctx, ObjectType object, uint32_t index, ReturnValue &return_value) {
+    auto& state = *get_internal<T, ResultsWindowClass<T>>(object)->m_state;
+    if (index >= state.size()) {
+        throw std::out_of_range("Index out of range");
+    }
+    NativeAccessor<T> accessor(ctx, state.results);
+    return_value.set(state.results.get(accessor, state.start + index));
+}
+
+template<typename T>
+void ResultsWindowClass<T>::move(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
+    args.validate_maximum(2);
+
+    auto& state = *get_internal<T, ResultsWindowClass<T>>(this_object)->m_state;
+    size_t start = validated_to_size(ctx, args[0], "start");
+    if (!Value::is_undefined(ctx, args[1])) {
+        state.count = validated_to_size(ctx, args[1], "count");
+    }
+    state.start = start;
+}
+
+template<typename T>
+void ResultsWindowClass<T>::add_listener(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
+    args.validate_maximum(2);
+
+    auto window = get_internal<T, ResultsWindowClass<T>>(this_object);
+    auto callback = Value::validated_to_function(ctx, args[0]);
+    auto options = CollectionClass<T>::validated_to_listener_options(ctx, args[1]);
+    if (!options.key_paths.empty() || options.throttle.count() > 0 || options.debounce.count() > 0) {
+        throw std::invalid_argument("Window listeners do not support 'keyPaths', 'throttleMs' or 'debounceMs'.");
+    }
+
+    auto listener_callback = window->m_notification_tokens.make_callback(ctx, callback, this_object, options.weak);
+    Protected<typename T::GlobalContext> protected_ctx(Context<T>::get_global_context(ctx));
+    auto listener = NotificationScheduler::make_listener(options.priority, [=](CollectionChangeSet const& change_set) {
+        HANDLESCOPE
+        if (!listener_callback.expired()) {
+            listener_callback.call(protected_ctx, CollectionClass<T>::create_collection_change_set(protected_ctx, change_set, options.index_format));
+        }
+    });
+
+    std::weak_ptr<typename ResultsWindow<T>::State> weak_state = window->m_state;
+    auto token = window->m_state->results.add_notification_callback([=](CollectionChangeSet const& changes, std::exception_ptr exception) {
+        auto state = weak_state.lock();
+        if (!state) {
+            return;
+        }
+        // The initial notification is always delivered, later ones only if the window changed.
+        if (changes.empty()) {
+            listener->deliver(changes);
+            return;
+        }
+        auto window_changes = window_change_set(changes, state->results.size(), state->start, state->count);
+        if (!window_changes.empty()) {
+            listener->deliver(window_changes);
+        }
+    });
+    window->m_notification_tokens.add(listener_callback, std::move(token));
+}
+
+template<typename T>
+void ResultsWindowClass<T>::remove_listener(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
+    args.validate_maximum(1);
+
+    auto callback = Value::validated_to_function(ctx, args[0]);
+    auto window = get_internal<T, ResultsWindowClass<T>>(this_object);
+    window->m_notification_tokens.remove(callback);
+}
+
+template<typename T>
+void ResultsWindowClass<T>::remove_all_listeners(ContextType ctx, ObjectType this_object, Arguments args, ReturnValue &return_value) {
+    args.validate_maximum(0);
+
+    auto window = get_internal<T, ResultsWindowClass<T>>(this_object);
+    window->m_notification_tokens.clear();
+}
+
+} // js
+} // realm
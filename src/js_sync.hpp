@@ -25,6 +25,7 @@
 #include "platform.hpp"
 #include "js_class.hpp"
 #include "js_collection.hpp"
+#include "listener_registry.hpp"
 #include "sync/sync_manager.hpp"
 #include "sync/sync_config.hpp"
 #include "sync/sync_session.hpp"
@@ -556,7 +557,7 @@ void SessionClass<T>::add_progress_notification(ContextType ctx, FunctionType, O
             callback_arguments[1] = Value::from_number(protected_ctx, transferrable_bytes);
 
             Function<T>::callback(protected_ctx, protected_callback, typename T::Object(), 2, callback_arguments);
-        });
+        }, EventLoopDispatcher<ProgressHandler>::latest());
 
         progressFunc = std::move(progress_handler);
 
@@ -669,7 +670,7 @@ public:
     Subscription(partial_sync::Subscription s) : partial_sync::Subscription(std::move(s)) {}
     Subscription(Subscription &&) = default;
 
-    std::vector<std::pair<Protected<typename T::Function>, partial_sync::SubscriptionNotificationToken>> m_notification_tokens;
+    ListenerRegistry<T, partial_sync::SubscriptionNotificationToken> m_notification_tokens;
 };
 
 template<typename T>
@@ -767,7 +768,7 @@ void SubscriptionClass<T>::add_listener(ContextType ctx, ObjectType this_object,
         Function::callback(protected_ctx, protected_callback, protected_this, 2, arguments);
     });
 
-    subscription->m_notification_tokens.emplace_back(protected_callback, std::move(token));
+    subscription->m_notification_tokens.add(protected_callback, std::move(token));
 }
 
 template<typename T>
@@ -776,13 +777,7 @@ void SubscriptionClass<T>::remove_listener(ContextType ctx, ObjectType this_obje
     auto subscription = get_internal<T, SubscriptionClass<T>>(this_object);
 
     auto callback = Value::validated_to_function(ctx, args[0]);
-    auto protected_function = Protected<FunctionType>(ctx, callback);
-
-    auto& tokens = subscription->m_notification_tokens;
-    auto compare = [&](auto&& token) {
-        return typename Protected<FunctionType>::Comparator()(token.first, protected_function);
-    };
-    tokens.erase(std::remove_if(tokens.begin(), tokens.end(), compare), tokens.end());
+    subscription->m_notification_tokens.remove(callback);
 }
 
 template<typename T>
@@ -21,6 +21,7 @@
 #include "execution_context_id.hpp"
 #include "property.hpp"
 
+#include <functional>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -283,6 +284,11 @@ struct Object {
         return create_array(ctx, 0, nullptr);
     }
 
+    static ObjectType create_uint32_array(ContextType, uint32_t, const uint32_t[]);
+    static ObjectType create_uint32_array(ContextType ctx, const std::vector<uint32_t> &values) {
+        return create_uint32_array(ctx, (uint32_t)values.size(), values.data());
+    }
+
     static ObjectType create_date(ContextType, double);
 
     template<typename ClassType>
@@ -309,6 +315,31 @@ class Protected {
     struct Comparator {
         bool operator()(const Protected<ValueType>& a, const Protected<ValueType>& b) const;
     };
+
+    // Consistent with Comparator, for objects.
+    struct Hasher {
+        size_t operator()(const Protected<ValueType>& value) const;
+    };
+};
+
+// Refers to an object without keeping it from being garbage collected. Copies refer to the same
+// handle. Once the object is collected, expired() returns true and `on_collected` is called from
+// within the garbage collector, so it must not use any JS values.
+// Engines without weak references keep the object alive, and it never expires.
+template<typename ValueType>
+class WeakProtected {
+    bool expired() const;
+    // Only valid while the object has not expired.
+    operator ValueType() const;
+
+    struct Comparator {
+        bool operator()(const WeakProtected<ValueType>& a, const WeakProtected<ValueType>& b) const;
+    };
+
+    // Stays the same after the object is collected.
+    struct Hasher {
+        size_t operator()(const WeakProtected<ValueType>& value) const;
+    };
 };
 
 template<typename T>
@@ -18,12 +18,20 @@
 
 #pragma once
 
+#include <algorithm>
+#include <future>
 #include <limits>
 #include <sstream>
 #include <stdexcept>
+#include <vector>
 
+#include "js_types.hpp"
+#include "list.hpp"
 #include "object_schema.hpp"
+#include "results.hpp"
 #include "shared_realm.hpp"
+#include "thread_safe_reference.hpp"
+#include "thread_pool.hpp"
 
 namespace realm {
 namespace js {
@@ -83,6 +91,226 @@ static inline void validate_argument_count_at_least(size_t count, size_t expecte
     }
 }
 
+static inline realm::Realm::Config config_for_background_thread(realm::Realm::Config config) {
+    // The background thread opens its own uncached instance, which must never call back into JS.
+    config.cache = false;
+    config.automatic_change_notifications = false;
+    config.execution_context = util::none;
+    config.schema = util::none;
+    config.migration_function = nullptr;
+    config.should_compact_on_launch_function = nullptr;
+    return config;
+}
+
+struct AggregateChunk {
+    size_t count = 0;
+    int64_t int_value = 0;
+    double double_value = 0;
+};
+
+static inline AggregateChunk aggregate_rows(realm::Query& query, size_t column, DataType type, AggregateFunc func, size_t begin, size_t end) {
+    AggregateChunk chunk;
+    switch (type) {
+        case type_Int:
+            switch (func) {
+                case AggregateFunc::Min: chunk.int_value = query.minimum_int(column, &chunk.count, begin, end); break;
+                case AggregateFunc::Max: chunk.int_value = query.maximum_int(column, &chunk.count, begin, end); break;
+                case AggregateFunc::Sum:
+                case AggregateFunc::Avg: chunk.int_value = query.sum_int(column, &chunk.count, begin, end); break;
+            }
+            break;
+        case type_Float:
+            switch (func) {
+                case AggregateFunc::Min: chunk.double_value = query.minimum_float(column, &chunk.count, begin, end); break;
+                case AggregateFunc::Max: chunk.double_value = query.maximum_float(column, &chunk.count, begin, end); break;
+                case AggregateFunc::Sum:
+                case AggregateFunc::Avg: chunk.double_value = query.sum_float(column, &chunk.count, begin, end); break;
+            }
+            break;
+        default:
+            switch (func) {
+                case AggregateFunc::Min: chunk.double_value = query.minimum_double(column, &chunk.count, begin, end); break;
+                case AggregateFunc::Max: chunk.double_value = query.maximum_double(column, &chunk.count, begin, end); break;
+                case AggregateFunc::Sum:
+                case AggregateFunc::Avg: chunk.double_value = query.sum_double(column, &chunk.count, begin, end); break;
+            }
+            break;
+    }
+    return chunk;
+}
+
+// Whether the rows of the results can be split into ranges of the table backing them, to be
+// aggregated separately on background threads.
+static inline bool can_aggregate_in_parallel(realm::Results& results) {
+    auto mode = results.get_mode();
+    if (mode != realm::Results::Mode::Table && mode != realm::Results::Mode::Query) {
+        return false;
+    }
+
+    auto realm = results.get_realm();
+    if (realm->is_in_transaction() || results.get_descriptor_ordering().will_apply_distinct()) {
+        return false;
+    }
+    return mode == realm::Results::Mode::Table || results.get_query().produces_results_in_table_order();
+}
+
+// Runs `aggregate(query, begin, end)` for chunks of the table backing the results on the shared thread
+// pool, each with its own Realm instance resolved at the version of the results, and returns the
+// partial results in order. Returns nothing if the table is too small to be worth splitting.
+template<typename Chunk, typename Aggregate>
+static inline std::vector<Chunk> aggregate_in_parallel(realm::Results& results, Aggregate aggregate) {
+    static const size_t min_rows_per_chunk = 100000;
+
+    size_t rows = results.get_table()->size();
+    auto& pool = ThreadPool::shared();
+    size_t chunks = std::min<size_t>(pool.size(), rows / min_rows_per_chunk);
+    std::vector<Chunk> partials;
+    if (chunks < 2) {
+        return partials;
+    }
+
+    auto realm = results.get_realm();
+    auto config = config_for_background_thread(realm->config());
+    std::vector<std::future<Chunk>> futures;
+    for (size_t i = 0; i < chunks; ++i) {
+        size_t begin = rows * i / chunks;
+        size_t end = rows * (i + 1) / chunks;
+        auto reference = std::make_shared<ThreadSafeReference<realm::Results>>(realm->obtain_thread_safe_reference(results));
+        futures.push_back(pool.submit([=] {
+            auto chunk_realm = realm::Realm::get_shared_realm(config);
+            auto chunk_results = chunk_realm->resolve_thread_safe_reference(std::move(*reference));
+            auto query = chunk_results.get_query();
+            auto chunk = aggregate(query, begin, end);
+            chunk_realm->close();
+            return chunk;
+        }));
+    }
+
+    for (auto& future : futures) {
+        partials.push_back(future.get());
+    }
+    return partials;
+}
+
+// Aggregates the rows of the results in chunks on the shared thread pool and merges the partial
+// results. Returns false if the results cannot be aggregated this way, in which case the caller
+// should compute the aggregate on the calling thread.
+static inline bool compute_parallel_aggregate(realm::Results& results, size_t column, AggregateFunc func, util::Optional<Mixed>& result) {
+    if (!can_aggregate_in_parallel(results)) {
+        return false;
+    }
+
+    DataType type = results.get_table()->get_column_type(column);
+    if (type != type_Int && type != type_Float && type != type_Double) {
+        return false;
+    }
+
+    auto partials = aggregate_in_parallel<AggregateChunk>(results, [=](realm::Query& query, size_t begin, size_t end) {
+        return aggregate_rows(query, column, type, func, begin, end);
+    });
+    if (partials.empty()) {
+        return false;
+    }
+
+    size_t count = 0;
+    for (auto& partial : partials) {
+        count += partial.count;
+    }
+
+    switch (func) {
+        case AggregateFunc::Min:
+        case AggregateFunc::Max: {
+            result = util::none;
+            bool is_min = func == AggregateFunc::Min;
+            for (auto& partial : partials) {
+                if (!partial.count) {
+                    continue;
+                }
+                if (type == type_Int) {
+                    if (!result || (is_min ? partial.int_value < result->get_int() : partial.int_value > result->get_int())) {
+                        result = Mixed(partial.int_value);
+                    }
+                }
+                else if (type == type_Float) {
+                    float value = static_cast<float>(partial.double_value);
+                    if (!result || (is_min ? value < result->get_float() : value > result->get_float())) {
+                        result = Mixed(value);
+                    }
+                }
+                else if (!result || (is_min ? partial.double_value < result->get_double() : partial.double_value > result->get_double())) {
+                    result = Mixed(partial.double_value);
+                }
+            }
+            break;
+        }
+        case AggregateFunc::Sum: {
+            int64_t int_sum = 0;
+            double double_sum = 0;
+            for (auto& partial : partials) {
+                int_sum += partial.int_value;
+                double_sum += partial.double_value;
+            }
+            result = type == type_Int ? Mixed(int_sum) : Mixed(double_sum);
+            break;
+        }
+        case AggregateFunc::Avg: {
+            if (!count) {
+                result = util::none;
+                break;
+            }
+            double sum = 0;
+            for (auto& partial : partials) {
+                sum += type == type_Int ? static_cast<double>(partial.int_value) : partial.double_value;
+            }
+            result = Mixed(sum / count);
+            break;
+        }
+    }
+    return true;
+}
+
+static inline bool compute_parallel_aggregate(realm::List&, size_t, AggregateFunc, util::Optional<Mixed>&) {
+    return false;
+}
+
+// Counts the rows of the results in chunks on the shared thread pool, as compute_parallel_aggregate()
+// does. Results of a whole table already know their size, so only queries are counted this way.
+static inline bool compute_parallel_count(realm::Results& results, size_t& count) {
+    if (results.get_mode() != realm::Results::Mode::Query || !can_aggregate_in_parallel(results)) {
+        return false;
+    }
+
+    auto partials = aggregate_in_parallel<size_t>(results, [](realm::Query& query, size_t begin, size_t end) {
+        return query.count(begin, end);
+    });
+    if (partials.empty()) {
+        return false;
+    }
+
+    count = 0;
+    for (size_t partial : partials) {
+        count += partial;
+    }
+    return true;
+}
+
+static inline bool compute_parallel_count(realm::List&, size_t&) {
+    return false;
+}
+
+// Whether the `parallel` property of the options argument at `index`, if there is one, is true.
+// `T` is the class definition of the collection.
+template<typename T>
+static inline bool validated_parallel_option(typename T::ContextType ctx, typename T::Arguments& args, size_t index) {
+    if (args.count <= index) {
+        return false;
+    }
+    static const String<typename T::Type> parallel_string = "parallel";
+    auto options = T::Value::validated_to_object(ctx, args[index], "options");
+    auto parallel = T::Object::get_property(ctx, options, parallel_string);
+    return !T::Value::is_undefined(ctx, parallel) && T::Value::validated_to_boolean(ctx, parallel, "parallel");
+}
+
 template<typename T, AggregateFunc func>
 void compute_aggregate_on_collection(typename T::ContextType ctx, typename T::ObjectType this_object,
                                      typename T::Arguments args, typename T::ReturnValue &return_value) {
@@ -99,12 +327,20 @@ void compute_aggregate_on_collection(typename T::ContextType ctx, typename T::Ob
                                                      property_name, object_schema.name));
         }
         column = property->table_column;
+
+        args.validate_maximum(2);
+        if (validated_parallel_option<T>(ctx, args, 1)) {
+            util::Optional<Mixed> result;
+            if (compute_parallel_aggregate(*list, column, func, result)) {
+                return_value.set(result);
+                return;
+            }
+        }
     }
     else {
         args.validate_maximum(0);
     }
 
-    util::Optional<Mixed> mixed;
     switch (func) {
         case AggregateFunc::Min:
             return_value.set(list->min(column));
@@ -121,5 +357,19 @@ void compute_aggregate_on_collection(typename T::ContextType ctx, typename T::Ob
     }
 }
 
+template<typename T>
+void compute_count_on_collection(typename T::ContextType ctx, typename T::ObjectType this_object,
+                                 typename T::Arguments args, typename T::ReturnValue &return_value) {
+    args.validate_maximum(1);
+    auto list = get_internal<typename T::Type, T>(this_object);
+
+    size_t count;
+    if (validated_parallel_option<T>(ctx, args, 0) && compute_parallel_count(*list, count)) {
+        return_value.set((uint32_t)count);
+        return;
+    }
+    return_value.set((uint32_t)list->size());
+}
+
 } // js
 } // realm
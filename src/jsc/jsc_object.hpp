@@ -107,6 +107,9 @@ inline JSObjectRef jsc::Object::create_array(JSContextRef ctx, uint32_t length,
     return array;
 }
 
+template<>
+JSObjectRef jsc::Object::create_uint32_array(JSContextRef ctx, uint32_t length, const uint32_t values[]);
+
 template<>
 inline JSObjectRef jsc::Object::create_date(JSContextRef ctx, double time) {
     JSValueRef number = jsc::Value::from_number(ctx, time);
@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "jsc_types.hpp"
 
 namespace realm {
@@ -62,7 +64,7 @@ class Protected<JSValueRef> {
     JSValueRef m_value;
 
   public:
-    Protected() {}
+    Protected() : m_context(nullptr), m_value(nullptr) {}
     Protected(const Protected<JSValueRef> &other) : Protected(other.m_context, other.m_value) {}
     Protected(Protected<JSValueRef> &&other) : m_context(other.m_context), m_value(other.m_value) {
         other.m_context = nullptr;
@@ -90,6 +92,19 @@ class Protected<JSValueRef> {
             }
             return JSValueIsStrictEqual(a.m_context, a.m_value, b.m_value);
         }
+        bool operator() (const Protected<JSValueRef>& a, JSValueRef b) const {
+            return JSValueIsStrictEqual(a.m_context, a.m_value, b);
+        }
+    };
+
+    // JSC does not move objects, so an object is identified by its address.
+    struct Hasher {
+        size_t operator()(const Protected<JSValueRef>& value) const {
+            return std::hash<JSValueRef>()(value.m_value);
+        }
+        size_t operator()(JSValueRef value) const {
+            return std::hash<JSValueRef>()(value);
+        }
     };
     
     Protected<JSValueRef>& operator=(Protected<JSValueRef> other) {
@@ -119,5 +134,18 @@ class Protected<JSObjectRef> : public Protected<JSValueRef> {
     }
 };
 
+// JavaScriptCore has no public API for weak references, so the object is kept alive.
+template<>
+class WeakProtected<JSObjectRef> : public Protected<JSObjectRef> {
+  public:
+    WeakProtected() : Protected<JSObjectRef>() {}
+    WeakProtected(JSContextRef ctx, JSObjectRef object, std::function<void()> on_collected = nullptr)
+    : Protected<JSObjectRef>(ctx, object) {}
+
+    bool expired() const {
+        return false;
+    }
+};
+
 } // js
 } // realm
@@ -114,5 +114,22 @@ OwnedBinaryData jsc::Value::to_binary(JSContextRef ctx, JSValueRef value)
     return OwnedBinaryData(std::move(buffer), byte_count);
 }
 
+template<>
+JSObjectRef jsc::Object::create_uint32_array(JSContextRef ctx, uint32_t length, const uint32_t values[])
+{
+    static jsc::String s_uint32_array = "Uint32Array";
+
+    // Indexes fit in an int32, which JSC stores unboxed, so filling the array does not allocate.
+    JSValueRef length_value = jsc::Value::from_number(ctx, length);
+    JSObjectRef uint32_array_constructor = jsc::Object::validated_get_constructor(ctx, JSContextGetGlobalObject(ctx), s_uint32_array);
+    JSObjectRef uint32_array = jsc::Function::construct(ctx, uint32_array_constructor, 1, &length_value);
+
+    for (uint32_t i = 0; i < length; i++) {
+        jsc::Object::set_property(ctx, uint32_array, i, jsc::Value::from_number(ctx, values[i]));
+    }
+
+    return uint32_array;
+}
+
 } // namespace js
 } // namespace realm
@@ -0,0 +1,302 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2018 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+#include <realm/util/optional.hpp>
+
+#include "event_loop_dispatcher.hpp"
+#include "js_types.hpp"
+
+namespace realm {
+namespace js {
+
+// The listeners of an object, keyed by their callback function and kept in the order they were
+// added. Callbacks are looked up by hashing the identity of the function, so adding and removing
+// a listener does not depend on the number of listeners. Lookups take either a `Callback` or the
+// function itself, so finding a listener does not need to protect the function first.
+// The listeners can be iterated with for_each() while they are added and removed: listeners added
+// meanwhile are left for the next iteration, and removed ones are skipped from then on.
+template<typename T, typename ValueType, typename Callback = Protected<typename T::Function>>
+class ListenerRegistry {
+  public:
+    ListenerRegistry() = default;
+    ListenerRegistry(const ListenerRegistry&) = delete;
+    ListenerRegistry& operator=(const ListenerRegistry&) = delete;
+    ListenerRegistry(ListenerRegistry&&) = default;
+    ListenerRegistry& operator=(ListenerRegistry&&) = default;
+
+    template<typename Key>
+    bool contains(const Key& callback) const {
+        auto range = m_index.equal_range(typename Callback::Hasher()(callback));
+        return std::any_of(range.first, range.second, [&](auto& index) {
+            return typename Callback::Comparator()(index.second->callback, callback);
+        });
+    }
+
+    bool empty() const {
+        return m_index.empty();
+    }
+
+    size_t size() const {
+        return m_index.size();
+    }
+
+    // Returns the value of a listener added with this callback, if any.
+    template<typename Key>
+    ValueType* find(const Key& callback) {
+        auto range = m_index.equal_range(typename Callback::Hasher()(callback));
+        for (auto it = range.first; it != range.second; ++it) {
+            if (typename Callback::Comparator()(it->second->callback, callback)) {
+                return &it->second->value;
+            }
+        }
+        return nullptr;
+    }
+
+    // The same callback can be added more than once.
+    void add(Callback callback, ValueType value) {
+        size_t hash = typename Callback::Hasher()(callback);
+        m_entries.push_back({std::move(callback), std::move(value), false});
+        m_index.emplace(hash, std::prev(m_entries.end()));
+    }
+
+    // Removes every listener added with this callback, and returns whether there were any.
+    template<typename Key>
+    bool remove(const Key& callback) {
+        bool removed = false;
+        auto range = m_index.equal_range(typename Callback::Hasher()(callback));
+        for (auto it = range.first; it != range.second;) {
+            if (typename Callback::Comparator()(it->second->callback, callback)) {
+                release(it->second);
+                it = m_index.erase(it);
+                removed = true;
+            }
+            else {
+                ++it;
+            }
+        }
+        return removed;
+    }
+
+    void clear() {
+        m_index.clear();
+        for (auto it = m_entries.begin(); it != m_entries.end();) {
+            release(it++);
+        }
+    }
+
+    // Removes the listeners whose callback matches `predicate`.
+    template<typename Predicate>
+    void remove_if(Predicate&& predicate) {
+        for (auto it = m_index.begin(); it != m_index.end();) {
+            if (predicate(it->second->callback)) {
+                release(it->second);
+                it = m_index.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    // Calls `function(callback, value)` for the listeners which existed when the iteration started and
+    // have not been removed since.
+    template<typename Function>
+    void for_each(Function&& function) {
+        IterationScope scope(*this);
+        auto it = m_entries.begin();
+        for (size_t count = m_entries.size(); count > 0; --count, ++it) {
+            if (!it->removed) {
+                function(it->callback, it->value);
+            }
+        }
+    }
+
+  private:
+    struct Entry {
+        Callback callback;
+        ValueType value;
+        bool removed;
+    };
+    using Iterator = typename std::list<Entry>::iterator;
+
+    // Removed entries stay in the list until no iteration is using it.
+    struct IterationScope {
+        ListenerRegistry& registry;
+
+        IterationScope(ListenerRegistry& registry) : registry(registry) {
+            ++registry.m_iterations;
+        }
+        ~IterationScope() {
+            if (--registry.m_iterations == 0 && registry.m_has_removed) {
+                registry.m_entries.remove_if([](const Entry& entry) { return entry.removed; });
+                registry.m_has_removed = false;
+            }
+        }
+    };
+
+    std::list<Entry> m_entries;
+    // The entries by the hash of their callback. Callbacks with the same hash are told apart by
+    // comparing them.
+    std::unordered_multimap<size_t, Iterator> m_index;
+    size_t m_iterations = 0;
+    bool m_has_removed = false;
+
+    void release(Iterator entry) {
+        if (m_iterations > 0) {
+            entry->removed = true;
+            m_has_removed = true;
+        }
+        else {
+            m_entries.erase(entry);
+        }
+    }
+};
+
+// The function of a listener and the object it was added to. A weak listener holds both weakly, and is
+// no longer called once either has been garbage collected.
+template<typename T>
+class ListenerCallback {
+    using ContextType = typename T::Context;
+    using FunctionType = typename T::Function;
+    using ObjectType = typename T::Object;
+    using ValueType = typename T::Value;
+
+  public:
+    ListenerCallback(ContextType ctx, FunctionType callback, ObjectType this_object)
+    : m_strong(Strong{{ctx, callback}, {ctx, this_object}}) {}
+
+    ListenerCallback(ContextType ctx, WeakProtected<FunctionType> callback, ObjectType this_object)
+    : m_weak(Weak{std::move(callback), {ctx, this_object}}) {}
+
+    bool expired() const {
+        return m_weak && (m_weak->callback.expired() || m_weak->this_object.expired());
+    }
+
+    // Calls the function with the object as `this` and as the first argument, followed by `changes`.
+    // Must not be called once expired.
+    void call(ContextType ctx, ValueType changes) const {
+        ObjectType this_object = m_weak ? static_cast<ObjectType>(m_weak->this_object) : static_cast<ObjectType>(m_strong->this_object);
+        FunctionType callback = m_weak ? static_cast<FunctionType>(m_weak->callback) : static_cast<FunctionType>(m_strong->callback);
+        ValueType arguments[] {this_object, changes};
+        Function<T>::callback(ctx, callback, this_object, 2, arguments);
+    }
+
+  private:
+    template<typename, typename>
+    friend class NotificationTokens;
+
+    struct Strong {
+        Protected<FunctionType> callback;
+        Protected<ObjectType> this_object;
+    };
+    struct Weak {
+        WeakProtected<FunctionType> callback;
+        WeakProtected<ObjectType> this_object;
+    };
+
+    util::Optional<Strong> m_strong;
+    util::Optional<Weak> m_weak;
+};
+
+// The notification tokens of the listeners of a collection or object. The tokens of weak listeners are
+// dropped on the next turn of the event loop after their function has been garbage collected, which
+// stops the notifications behind them.
+template<typename T, typename TokenType>
+class NotificationTokens {
+    using ContextType = typename T::Context;
+    using FunctionType = typename T::Function;
+    using ObjectType = typename T::Object;
+
+  public:
+    ListenerCallback<T> make_callback(ContextType ctx, FunctionType callback, ObjectType this_object, bool weak) {
+        if (!weak) {
+            return ListenerCallback<T>(ctx, callback, this_object);
+        }
+
+        if (!m_weak_tokens) {
+            m_weak_tokens = std::make_shared<WeakTokens>();
+        }
+        std::weak_ptr<WeakTokens> weak_tokens = m_weak_tokens;
+        WeakProtected<FunctionType> weak_callback(ctx, callback, [weak_tokens] {
+            if (auto tokens = weak_tokens.lock()) {
+                tokens->schedule_purge();
+            }
+        });
+        return ListenerCallback<T>(ctx, std::move(weak_callback), this_object);
+    }
+
+    void add(const ListenerCallback<T>& callback, TokenType token) {
+        if (callback.m_weak) {
+            m_weak_tokens->tokens.add(callback.m_weak->callback, std::move(token));
+        }
+        else {
+            m_tokens.add(callback.m_strong->callback, std::move(token));
+        }
+    }
+
+    void remove(FunctionType callback) {
+        m_tokens.remove(callback);
+        if (m_weak_tokens) {
+            m_weak_tokens->tokens.remove(callback);
+        }
+    }
+
+    void clear() {
+        m_tokens.clear();
+        if (m_weak_tokens) {
+            m_weak_tokens->tokens.clear();
+        }
+    }
+
+  private:
+    struct WeakTokens : public _impl::DispatchQueue::Entry, public std::enable_shared_from_this<WeakTokens> {
+        ListenerRegistry<T, TokenType, WeakProtected<FunctionType>> tokens;
+        const std::shared_ptr<_impl::DispatchQueue> queue = _impl::DispatchQueue::for_current_thread();
+        bool purge_scheduled = false;
+
+        // Called by the garbage collector, which must not be re-entered, so the tokens are only
+        // dropped once the queue is drained.
+        void schedule_purge() {
+            if (!purge_scheduled) {
+                purge_scheduled = true;
+                queue->schedule(this->shared_from_this());
+            }
+        }
+
+        void drain() override {
+            purge_scheduled = false;
+            tokens.remove_if([](const WeakProtected<FunctionType>& callback) {
+                return callback.expired();
+            });
+        }
+    };
+
+    ListenerRegistry<T, TokenType> m_tokens;
+    std::shared_ptr<WeakTokens> m_weak_tokens;
+};
+
+} // js
+} // realm
@@ -18,6 +18,9 @@
 
 #pragma once
 
+#include <mutex>
+#include <unordered_map>
+
 #include "node_types.hpp"
 
 #include "js_class.hpp"
@@ -37,6 +40,47 @@ using PropertyType = js::PropertyType<Types>;
 using IndexPropertyType = js::IndexPropertyType<Types>;
 using StringPropertyType = js::StringPropertyType<Types>;
 
+// Function templates belong to the isolate which created them, so every isolate which loads the
+// module (the main thread as well as each worker thread) needs its own set. The templates of an
+// isolate are released when its environment is torn down.
+class TemplateRegistry {
+  public:
+    static v8::Local<v8::FunctionTemplate> get(v8::Isolate* isolate, const void* key) {
+        std::lock_guard<std::mutex> lock(mutex());
+        auto isolate_templates = templates().find(isolate);
+        if (isolate_templates != templates().end()) {
+            auto it = isolate_templates->second.find(key);
+            if (it != isolate_templates->second.end()) {
+                return Nan::New(it->second);
+            }
+        }
+        return v8::Local<v8::FunctionTemplate>();
+    }
+
+    static void set(v8::Isolate* isolate, const void* key, v8::Local<v8::FunctionTemplate> tpl) {
+        std::lock_guard<std::mutex> lock(mutex());
+        templates()[isolate][key].Reset(tpl);
+    }
+
+    static void clear(v8::Isolate* isolate) {
+        std::lock_guard<std::mutex> lock(mutex());
+        templates().erase(isolate);
+    }
+
+  private:
+    using TemplateMap = std::unordered_map<const void*, Nan::Global<v8::FunctionTemplate>>;
+
+    static std::mutex& mutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static std::unordered_map<v8::Isolate*, TemplateMap>& templates() {
+        static std::unordered_map<v8::Isolate*, TemplateMap> templates;
+        return templates;
+    }
+};
+
 template<typename ClassType>
 class ObjectWrap : public Nan::ObjectWrap {
     using Internal = typename ClassType::Internal;
@@ -47,8 +91,13 @@ class ObjectWrap : public Nan::ObjectWrap {
     static v8::Local<v8::Object> create_instance(v8::Isolate*, Internal* = nullptr);
 
     static v8::Local<v8::FunctionTemplate> get_template() {
-        static Nan::Persistent<v8::FunctionTemplate> js_template(create_template());
-        return Nan::New(js_template);
+        v8::Isolate* isolate = v8::Isolate::GetCurrent();
+        v8::Local<v8::FunctionTemplate> js_template = TemplateRegistry::get(isolate, &s_class);
+        if (js_template.IsEmpty()) {
+            js_template = create_template();
+            TemplateRegistry::set(isolate, &s_class, js_template);
+        }
+        return js_template;
     }
 
     static void construct(const v8::FunctionCallbackInfo<v8::Value>&);
@@ -27,9 +27,26 @@ static void init(v8::Local<v8::Object> exports) {
     v8::Local<v8::Function> realm_constructor = js::RealmClass<Types>::create_constructor(isolate);
 
     Nan::Set(exports, realm_constructor->GetName(), realm_constructor);
+
+#if defined(NODE_MODULE_INIT)
+    // Worker threads tear down their isolate when they exit. Close the Realms they opened and drop
+    // their templates so that nothing refers to the isolate once it is gone.
+    ::node::AddEnvironmentCleanupHook(isolate, [](void* data) {
+        auto isolate = static_cast<v8::Isolate*>(data);
+        js::close_realms_for_execution_context(Context::get_execution_context_id(isolate));
+        TemplateRegistry::clear(isolate);
+    }, isolate);
+#endif
 }
 
 } // node
 } // realm
 
+#if defined(NODE_MODULE_INIT)
+// Context-aware modules can be loaded by each worker thread.
+NODE_MODULE_INIT() {
+    realm::node::init(exports);
+}
+#else
 NODE_MODULE(Realm, realm::node::init);
+#endif
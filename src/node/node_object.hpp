@@ -135,6 +135,15 @@ inline v8::Local<v8::Object> node::Object::create_array(v8::Isolate* isolate, ui
     return array;
 }
 
+template<>
+inline v8::Local<v8::Object> node::Object::create_uint32_array(v8::Isolate* isolate, uint32_t length, const uint32_t values[]) {
+    v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(isolate, length * sizeof(uint32_t));
+    if (length) {
+        memcpy(buffer->GetContents().Data(), values, length * sizeof(uint32_t));
+    }
+    return v8::Uint32Array::New(buffer, 0, length);
+}
+
 template<>
 inline v8::Local<v8::Object> node::Object::create_date(v8::Isolate* isolate, double time) {
     return Nan::New<v8::Date>(time).ToLocalChecked();
@@ -18,6 +18,9 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+
 #include "node_types.hpp"
 
 namespace realm {
@@ -55,6 +58,81 @@ class Protected {
         bool operator()(const Protected<MemberType>& a, const Protected<MemberType>& b) const {
             return Nan::New(a.m_value)->StrictEquals(Nan::New(b.m_value));
         }
+        bool operator()(const Protected<MemberType>& a, v8::Local<MemberType> b) const {
+            return Nan::New(a.m_value)->StrictEquals(b);
+        }
+    };
+
+    // Objects can be moved by the garbage collector, so they are hashed by their identity hash.
+    struct Hasher {
+        size_t operator()(const Protected<MemberType>& value) const {
+            return Nan::New(value.m_value)->GetIdentityHash();
+        }
+        size_t operator()(v8::Local<MemberType> value) const {
+            return value->GetIdentityHash();
+        }
+    };
+};
+
+template<typename MemberType>
+class WeakProtected {
+    struct State {
+        v8::Persistent<MemberType> handle;
+        size_t hash;
+        std::function<void()> on_collected;
+
+        ~State() {
+            handle.Reset();
+        }
+    };
+    std::shared_ptr<State> m_state;
+
+  public:
+    WeakProtected() {}
+    WeakProtected(v8::Local<MemberType> value, std::function<void()> on_collected) : m_state(std::make_shared<State>()) {
+        m_state->handle.Reset(v8::Isolate::GetCurrent(), value);
+        m_state->hash = value->GetIdentityHash();
+        m_state->on_collected = std::move(on_collected);
+
+        // Not called once the state, and with it the handle, is destroyed.
+        m_state->handle.SetWeak(m_state.get(), [](const v8::WeakCallbackInfo<State>& info) {
+            State* state = info.GetParameter();
+            state->handle.Reset();
+            if (state->on_collected) {
+                state->on_collected();
+            }
+        }, v8::WeakCallbackType::kParameter);
+    }
+
+    bool expired() const {
+        return !m_state || m_state->handle.IsEmpty();
+    }
+    operator v8::Local<MemberType>() const {
+        return Nan::New(m_state->handle);
+    }
+
+    struct Comparator {
+        bool operator()(const WeakProtected<MemberType>& a, const WeakProtected<MemberType>& b) const {
+            if (a.m_state == b.m_state) {
+                return true;
+            }
+            if (a.expired() || b.expired()) {
+                return false;
+            }
+            return Nan::New(a.m_state->handle)->StrictEquals(Nan::New(b.m_state->handle));
+        }
+        bool operator()(const WeakProtected<MemberType>& a, v8::Local<MemberType> b) const {
+            return !a.expired() && Nan::New(a.m_state->handle)->StrictEquals(b);
+        }
+    };
+
+    struct Hasher {
+        size_t operator()(const WeakProtected<MemberType>& value) const {
+            return value.m_state ? value.m_state->hash : 0;
+        }
+        size_t operator()(v8::Local<MemberType> value) const {
+            return value->GetIdentityHash();
+        }
     };
 };
 
@@ -94,6 +172,22 @@ class Protected<node::Types::Function> : public node::Protected<v8::Function> {
     Protected(v8::Isolate* isolate, v8::Local<v8::Function> object) : node::Protected<v8::Function>(object) {}
 };
 
+template<>
+class WeakProtected<node::Types::Object> : public node::WeakProtected<v8::Object> {
+  public:
+    WeakProtected() : node::WeakProtected<v8::Object>() {}
+    WeakProtected(v8::Isolate* isolate, v8::Local<v8::Object> object, std::function<void()> on_collected = nullptr)
+    : node::WeakProtected<v8::Object>(object, std::move(on_collected)) {}
+};
+
+template<>
+class WeakProtected<node::Types::Function> : public node::WeakProtected<v8::Function> {
+  public:
+    WeakProtected() : node::WeakProtected<v8::Function>() {}
+    WeakProtected(v8::Isolate* isolate, v8::Local<v8::Function> function, std::function<void()> on_collected = nullptr)
+    : node::WeakProtected<v8::Function>(function, std::move(on_collected)) {}
+};
+
 template<typename T>
 struct GlobalCopyablePersistentTraits {
     typedef v8::Persistent<T, GlobalCopyablePersistentTraits<T>> CopyablePersistent;
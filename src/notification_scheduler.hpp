@@ -0,0 +1,230 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2018 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <vector>
+
+#include <realm/util/optional.hpp>
+
+#include "collection_notifications.hpp"
+#include "impl/collection_change_builder.hpp"
+
+#include "event_loop_dispatcher.hpp"
+
+namespace realm {
+namespace js {
+
+// The change sets a listener has received but not yet been called with, merged into one. The builder
+// tracks modifications by their index after the change, but not the modified properties of objects,
+// which are merged here.
+class PendingChanges {
+  public:
+    bool empty() const {
+        return !m_changes;
+    }
+
+    void add(CollectionChangeSet const& change_set) {
+        _impl::CollectionChangeBuilder changes(change_set.deletions, change_set.insertions,
+                                               change_set.modifications_new, change_set.moves);
+        if (m_changes) {
+            m_changes->merge(std::move(changes));
+        }
+        else {
+            m_changes = std::move(changes);
+        }
+        if (m_columns.size() < change_set.columns.size()) {
+            m_columns.resize(change_set.columns.size());
+        }
+        for (size_t i = 0; i < change_set.columns.size(); i++) {
+            m_columns[i].add(change_set.columns[i]);
+        }
+    }
+
+    // Returns the merged changes and leaves this empty.
+    CollectionChangeSet finalize() {
+        CollectionChangeSet change_set = std::move(*m_changes).finalize();
+        change_set.columns = std::move(m_columns);
+        m_changes = util::none;
+        m_columns.clear();
+        return change_set;
+    }
+
+  private:
+    util::Optional<_impl::CollectionChangeBuilder> m_changes;
+    std::vector<IndexSet> m_columns;
+};
+
+// Delivers change notifications to JS listeners within a time budget per turn of the event loop.
+// Without a budget, listeners are called as soon as their notification arrives. With one, the
+// notifications are queued by listener priority, and once the budget of a turn is spent the rest
+// are delivered on the next turn. A listener which receives further changes while it is waiting
+// gets them merged into a single change set.
+// There is one scheduler per thread, and it must only be used on that thread.
+class NotificationScheduler : public _impl::DispatchQueue::Entry, public std::enable_shared_from_this<NotificationScheduler> {
+  public:
+    using Clock = std::chrono::steady_clock;
+    using Deliver = std::function<void(CollectionChangeSet const&)>;
+
+    struct Metrics {
+        uint64_t ticks = 0;           // turns of the event loop that delivered queued notifications
+        uint64_t delivered = 0;       // listener calls, including those made without queueing
+        uint64_t deferred = 0;        // notifications left for a later turn because the budget was spent
+        Clock::duration last_tick{0};
+        Clock::duration max_tick{0};
+        Clock::duration total{0};
+    };
+
+    class Listener : public std::enable_shared_from_this<Listener> {
+      public:
+        Listener(std::shared_ptr<NotificationScheduler> scheduler, int priority, Deliver deliver)
+        : m_scheduler(std::move(scheduler)), m_priority(priority), m_deliver(std::move(deliver)) {}
+
+        void deliver(CollectionChangeSet const& change_set) {
+            m_scheduler->deliver(*this, change_set);
+        }
+
+      private:
+        friend class NotificationScheduler;
+
+        const std::shared_ptr<NotificationScheduler> m_scheduler;
+        const int m_priority;
+        const Deliver m_deliver;
+        PendingChanges m_pending;
+    };
+
+    static std::shared_ptr<Listener> make_listener(int priority, Deliver deliver) {
+        return std::make_shared<Listener>(for_current_thread(), priority, std::move(deliver));
+    }
+
+    // A zero budget delivers every notification right away.
+    static std::chrono::microseconds& budget() {
+        static thread_local std::chrono::microseconds t_budget{0};
+        return t_budget;
+    }
+
+    static Metrics& metrics() {
+        static thread_local Metrics t_metrics;
+        return t_metrics;
+    }
+
+    NotificationScheduler() : m_queue(_impl::DispatchQueue::for_current_thread()) {}
+
+    void drain() override {
+        m_scheduled = false;
+        auto& stats = metrics();
+        auto start = Clock::now();
+        auto deadline = start + budget();
+        bool delivered_any = false;
+
+        try {
+            while (!m_pending.empty()) {
+                if (delivered_any && budget().count() > 0 && Clock::now() >= deadline) {
+                    stats.deferred += m_pending.size();
+                    schedule();
+                    break;
+                }
+
+                auto listener = m_pending.top().listener.lock();
+                m_pending.pop();
+                if (!listener || listener->m_pending.empty()) {
+                    continue;
+                }
+
+                auto change_set = listener->m_pending.finalize();
+                delivered_any = true;
+                ++stats.delivered;
+                listener->m_deliver(change_set);
+            }
+        }
+        catch (...) {
+            record_tick(start);
+            if (!m_pending.empty()) {
+                schedule();
+            }
+            throw;
+        }
+        record_tick(start);
+    }
+
+  private:
+    struct Pending {
+        int priority;
+        uint64_t sequence;
+        std::weak_ptr<Listener> listener;
+
+        // Highest priority first, then in arrival order.
+        bool operator<(const Pending& other) const {
+            return priority != other.priority ? priority < other.priority : sequence > other.sequence;
+        }
+    };
+
+    const std::shared_ptr<_impl::DispatchQueue> m_queue;
+    std::priority_queue<Pending> m_pending;
+    uint64_t m_sequence = 0;
+    bool m_scheduled = false;
+
+    static std::shared_ptr<NotificationScheduler> for_current_thread() {
+        static thread_local std::weak_ptr<NotificationScheduler> t_scheduler;
+        auto scheduler = t_scheduler.lock();
+        if (!scheduler) {
+            scheduler = std::make_shared<NotificationScheduler>();
+            t_scheduler = scheduler;
+        }
+        return scheduler;
+    }
+
+    void deliver(Listener& listener, CollectionChangeSet const& change_set) {
+        if (budget().count() == 0 && m_pending.empty()) {
+            ++metrics().delivered;
+            listener.m_deliver(change_set);
+            return;
+        }
+
+        bool waiting = !listener.m_pending.empty();
+        listener.m_pending.add(change_set);
+        if (waiting) {
+            return;
+        }
+        m_pending.push({listener.m_priority, m_sequence++, listener.shared_from_this()});
+        if (!m_scheduled) {
+            schedule();
+        }
+    }
+
+    void schedule() {
+        m_scheduled = true;
+        m_queue->schedule(shared_from_this());
+    }
+
+    void record_tick(Clock::time_point start) {
+        auto& stats = metrics();
+        auto elapsed = Clock::now() - start;
+        ++stats.ticks;
+        stats.last_tick = elapsed;
+        stats.max_tick = std::max(stats.max_tick, elapsed);
+        stats.total += elapsed;
+    }
+};
+
+} // js
+} // realm
@@ -0,0 +1,244 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2018 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+
+#include <realm/util/optional.hpp>
+
+#include "collection_notifications.hpp"
+#include "impl/collection_change_builder.hpp"
+
+#include "event_loop_dispatcher.hpp"
+
+namespace realm {
+namespace js {
+
+// A single background thread which runs functions once their deadline has passed. The functions
+// are expected to be cheap, typically an EventLoopDispatcher which hands the work to a JS thread.
+class NotificationTimer {
+  public:
+    using Clock = std::chrono::steady_clock;
+    using Id = uint64_t;
+
+    static NotificationTimer& shared() {
+        static NotificationTimer timer;
+        return timer;
+    }
+
+    Id schedule(Clock::time_point deadline, std::function<void()> function) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Id id = ++m_last_id;
+        m_functions.emplace(id, std::make_pair(deadline, std::move(function)));
+        add_deadline(deadline, id);
+        return id;
+    }
+
+    // Moves the function scheduled as `id` to a new deadline. Returns false if it has already run,
+    // or is running.
+    bool reschedule(Id id, Clock::time_point deadline) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_functions.find(id);
+        if (it == m_functions.end()) {
+            return false;
+        }
+        m_deadlines.erase({it->second.first, id});
+        it->second.first = deadline;
+        add_deadline(deadline, id);
+        return true;
+    }
+
+    void cancel(Id id) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_functions.find(id);
+        if (it != m_functions.end()) {
+            m_deadlines.erase({it->second.first, id});
+            m_functions.erase(it);
+        }
+    }
+
+    ~NotificationTimer() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+            m_condition.notify_one();
+        }
+        m_thread.join();
+    }
+
+  private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::map<Id, std::pair<Clock::time_point, std::function<void()>>> m_functions;
+    std::set<std::pair<Clock::time_point, Id>> m_deadlines;
+    Id m_last_id = 0;
+    bool m_stop = false;
+    std::thread m_thread;
+
+    NotificationTimer() : m_thread([this] { run(); }) {}
+
+    void add_deadline(Clock::time_point deadline, Id id) {
+        bool earliest = m_deadlines.empty() || deadline < m_deadlines.begin()->first;
+        m_deadlines.emplace(deadline, id);
+        if (earliest) {
+            m_condition.notify_one();
+        }
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_stop) {
+            if (m_deadlines.empty()) {
+                m_condition.wait(lock);
+                continue;
+            }
+            auto next = m_deadlines.begin();
+            if (Clock::now() < next->first) {
+                m_condition.wait_until(lock, next->first);
+                continue;
+            }
+            auto it = m_functions.find(next->second);
+            auto function = std::move(it->second.second);
+            m_functions.erase(it);
+            m_deadlines.erase(next);
+
+            lock.unlock();
+            function();
+            lock.lock();
+        }
+    }
+};
+
+// Delays the delivery of change notifications to a listener, merging the change sets that arrive
+// in the meantime:
+// - with a throttle interval, the listener is called at most once per interval,
+// - with a debounce interval, it is called once no changes arrived for that long. A throttle interval
+//   given as well bounds how long a steady stream of changes can hold back delivery.
+// Must be created and used on the thread which delivers the notifications.
+class NotificationThrottle {
+  public:
+    using Clock = NotificationTimer::Clock;
+    using Deliver = std::function<void(CollectionChangeSet const&)>;
+
+    static std::shared_ptr<NotificationThrottle> create(std::chrono::milliseconds throttle, std::chrono::milliseconds debounce, Deliver deliver) {
+        auto throttle_state = std::shared_ptr<NotificationThrottle>(new NotificationThrottle(throttle, debounce, std::move(deliver)));
+        std::weak_ptr<NotificationThrottle> weak_state = throttle_state;
+        throttle_state->m_wakeup = std::make_shared<EventLoopDispatcher<void(uint64_t)>>([=](uint64_t generation) {
+            if (auto state = weak_state.lock()) {
+                state->fire(generation);
+            }
+        }, EventLoopDispatcher<void(uint64_t)>::latest());
+        return throttle_state;
+    }
+
+    void add(CollectionChangeSet const& change_set) {
+        auto now = Clock::now();
+
+        // The builder tracks modifications by their index after the change.
+        _impl::CollectionChangeBuilder changes(change_set.deletions, change_set.insertions,
+                                               change_set.modifications_new, change_set.moves);
+        if (m_pending) {
+            m_pending->merge(std::move(changes));
+        }
+        else {
+            m_pending = std::move(changes);
+            m_first_pending = now;
+        }
+
+        if (m_debounce.count() > 0) {
+            auto deadline = now + m_debounce;
+            if (m_throttle.count() > 0) {
+                deadline = std::min(deadline, m_first_pending + m_throttle);
+            }
+            schedule(deadline);
+        }
+        else if (!m_timer_scheduled) {
+            schedule(m_last_delivery + m_throttle);
+        }
+    }
+
+  private:
+    const std::chrono::milliseconds m_throttle;
+    const std::chrono::milliseconds m_debounce;
+    const Deliver m_deliver;
+    std::shared_ptr<EventLoopDispatcher<void(uint64_t)>> m_wakeup;
+
+    util::Optional<_impl::CollectionChangeBuilder> m_pending;
+    Clock::time_point m_first_pending;
+    Clock::time_point m_last_delivery;
+    bool m_timer_scheduled = false;
+    // The pending timer is moved when the deadline changes, rather than scheduling another one.
+    NotificationTimer::Id m_timer_id = 0;
+    // Timers which were replaced are ignored if they fire anyway.
+    uint64_t m_generation = 0;
+
+    NotificationThrottle(std::chrono::milliseconds throttle, std::chrono::milliseconds debounce, Deliver deliver)
+    : m_throttle(throttle), m_debounce(debounce), m_deliver(std::move(deliver)) {}
+
+    void schedule(Clock::time_point deadline) {
+        auto& timer = NotificationTimer::shared();
+        if (deadline <= Clock::now()) {
+            if (m_timer_scheduled) {
+                timer.cancel(m_timer_id);
+            }
+            ++m_generation;
+            m_timer_scheduled = false;
+            deliver();
+            return;
+        }
+
+        if (m_timer_scheduled && timer.reschedule(m_timer_id, deadline)) {
+            return;
+        }
+
+        uint64_t generation = ++m_generation;
+        m_timer_scheduled = true;
+        auto wakeup = m_wakeup;
+        m_timer_id = timer.schedule(deadline, [=] { (*wakeup)(generation); });
+    }
+
+    void fire(uint64_t generation) {
+        if (generation != m_generation) {
+            return;
+        }
+        m_timer_scheduled = false;
+        deliver();
+    }
+
+    void deliver() {
+        if (!m_pending) {
+            return;
+        }
+        auto change_set = std::move(*m_pending).finalize();
+        m_pending = util::none;
+        m_last_delivery = Clock::now();
+        m_deliver(change_set);
+    }
+};
+
+} // js
+} // realm
@@ -16,12 +16,14 @@
 //
 ////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <cassert>
 #include <dlfcn.h>
 #include <map>
 #include <string>
 
 #include "rpc.hpp"
+#include "rpc_cbor.hpp"
 #include "jsc_init.hpp"
 
 #include "base64.hpp"
@@ -42,6 +44,7 @@ static const char * const RealmObjectTypesFunction = "function";
 static const char * const RealmObjectTypesList = "list";
 static const char * const RealmObjectTypesObject = "object";
 static const char * const RealmObjectTypesResults = "results";
+static const char * const RealmObjectTypesResultsWindow = "resultswindow";
 static const char * const RealmObjectTypesRealm = "realm";
 static const char * const RealmObjectTypesUser = "user";
 static const char * const RealmObjectTypesSession = "session";
@@ -65,6 +68,43 @@ json serialize_object_schema(const realm::ObjectSchema &object_schema) {
     };
 }
 
+// Operations in a /batch request can refer to the serialized result of an earlier operation with
+// {"batchResult": index}. Object ids are given the same way and resolve to the id of that result.
+json resolve_batch_references(const json &value, const std::vector<json> &results) {
+    if (value.is_object()) {
+        auto reference = value.find("batchResult");
+        if (reference != value.end() && value.size() == 1) {
+            size_t index = reference->get<size_t>();
+            if (index >= results.size()) {
+                throw std::out_of_range("Batch operations can only refer to the results of earlier operations");
+            }
+            return results[index];
+        }
+
+        json resolved = json::object();
+        for (auto it = value.begin(); it != value.end(); ++it) {
+            resolved[it.key()] = resolve_batch_references(it.value(), results);
+        }
+
+        auto id = resolved.find("id");
+        if (id != resolved.end() && id->is_object()) {
+            if (!id->count("id")) {
+                throw std::invalid_argument("Batch result used as an id does not refer to an object");
+            }
+            *id = json((*id)["id"]);
+        }
+        return resolved;
+    }
+    if (value.is_array()) {
+        json resolved = json::array();
+        for (auto &item : value) {
+            resolved.push_back(resolve_batch_references(item, results));
+        }
+        return resolved;
+    }
+    return value;
+}
+
 template<typename Container>
 json get_type(Container const& c) {
     auto type = c.get_type();
@@ -114,7 +154,19 @@ RPCWorker::~RPCWorker() {
 }
 
 void RPCWorker::add_task(std::function<json()> task) {
-    m_tasks.push_back(std::packaged_task<json()>(task));
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::packaged_task<json()>(task));
+    }
+    m_condition.notify_all();
+}
+
+void RPCWorker::wake() {
+    // Taking the lock makes sure a thread about to wait sees whatever changed before this call.
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+    }
+    m_condition.notify_all();
 }
 
 json RPCWorker::pop_task_result() {
@@ -140,20 +192,46 @@ bool RPCWorker::try_run_task() {
         return true;
     }
 
-    // Use a 10 millisecond timeout to keep this thread unblocked.
-    auto task = m_tasks.try_pop_back(10);
-    if (!task) {
-        return false;
+    // Wait at most 10 milliseconds so that the run loop this is called from stays responsive.
+    // A task which is added in the meantime wakes this thread immediately.
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait_for(lock, std::chrono::milliseconds(10), [this] { return m_stop || !m_tasks.empty(); });
+    if (m_tasks.empty()) {
+        return m_stop;
     }
 
-    (*task)();
-
-    // Since this can be called recursively, it must be pushed to the front of the queue *after* running the task.
-    m_futures.push_front(task->get_future());
+    auto task = std::move(m_tasks.back());
+    m_tasks.pop_back();
+    lock.unlock();
 
+    run_task(std::move(task));
     return m_stop;
 }
 
+void RPCWorker::run_tasks_until(std::function<bool()> done) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_condition.wait(lock, [&] { return m_stop || done() || !m_tasks.empty(); });
+        if (m_stop || done()) {
+            return;
+        }
+
+        auto task = std::move(m_tasks.back());
+        m_tasks.pop_back();
+        lock.unlock();
+
+        run_task(std::move(task));
+        lock.lock();
+    }
+}
+
+void RPCWorker::run_task(std::packaged_task<json()> task) {
+    task();
+
+    // Since this can be called recursively, it must be pushed to the front of the queue *after* running the task.
+    m_futures.push_front(task.get_future());
+}
+
 bool RPCWorker::should_stop() {
     return m_stop;
 }
@@ -161,6 +239,7 @@ bool RPCWorker::should_stop() {
 void RPCWorker::stop() {
     if (!m_stop) {
         m_stop = true;
+        wake();
 #if __APPLE__
         m_thread.join();
         m_loop = nullptr;
@@ -192,10 +271,19 @@ RPCServer::RPCServer() {
         jsc::Object::set_property(m_context, user_constructor, "_refreshAccessToken", refreshAccessTokenCallback);
 
         m_session_id = store_object(realm_constructor);
-        return (json){{"result", m_session_id}};
+
+        // Clients which support the binary protocol list it in "protocols".
+        m_binary_protocol = false;
+        for (auto &protocol : dict.value("protocols", json::array())) {
+            if (protocol == "cbor") {
+                m_binary_protocol = true;
+                break;
+            }
+        }
+        return (json){{"result", m_session_id}, {"protocol", m_binary_protocol ? "cbor" : "json"}};
     };
     m_requests["/create_realm"] = [this](const json dict) {
-        JSObjectRef realm_constructor = m_session_id ? JSObjectRef(m_objects[m_session_id]) : NULL;
+        JSObjectRef realm_constructor = m_session_id ? m_objects.get(m_context, m_session_id) : NULL;
         if (!realm_constructor) {
             throw std::runtime_error("Realm constructor not found!");
         }
@@ -213,7 +301,7 @@ RPCServer::RPCServer() {
         return (json){{"result", realm_id}};
     };
     m_requests["/create_user"] = [this](const json dict) {
-        JSObjectRef realm_constructor = m_session_id ? JSObjectRef(m_objects[m_session_id]) : NULL;
+        JSObjectRef realm_constructor = m_session_id ? m_objects.get(m_context, m_session_id) : NULL;
         if (!realm_constructor) {
             throw std::runtime_error("Realm constructor not found!");
         }
@@ -234,7 +322,7 @@ RPCServer::RPCServer() {
         return (json){{"result", serialize_json_value(user_object)}};
     };
     m_requests["/_adminUser"] = [this](const json dict) {
-        JSObjectRef realm_constructor = m_session_id ? JSObjectRef(m_objects[m_session_id]) : NULL;
+        JSObjectRef realm_constructor = m_session_id ? m_objects.get(m_context, m_session_id) : NULL;
         if (!realm_constructor) {
             throw std::runtime_error("Realm constructor not found!");
         }
@@ -255,7 +343,7 @@ RPCServer::RPCServer() {
         return (json){{"result", serialize_json_value(user_object)}};
     };
     m_requests["/_getExistingUser"] = [this](const json dict) {
-        JSObjectRef realm_constructor = m_session_id ? JSObjectRef(m_objects[m_session_id]) : NULL;
+        JSObjectRef realm_constructor = m_session_id ? m_objects.get(m_context, m_session_id) : NULL;
         if (!realm_constructor) {
             throw std::runtime_error("Realm constructor not found!");
         }
@@ -277,10 +365,16 @@ RPCServer::RPCServer() {
 
     };
     m_requests["/call_method"] = [this](const json dict) {
-        JSObjectRef object = m_objects[dict["id"].get<RPCObjectID>()];
+        RPCObjectID oid = dict["id"].get<RPCObjectID>();
+        JSObjectRef object = m_objects.get(m_context, oid);
         std::string method_string = dict["name"].get<std::string>();
         JSObjectRef function = jsc::Object::validated_get_function(m_context, object, method_string);
 
+        // Listeners are registered on the object itself, so a recreated object would not have them.
+        if (method_string == "addListener") {
+            m_objects.keep_pinned(oid);
+        }
+
         json args = dict["arguments"];
         size_t arg_count = args.size();
         JSValueRef arg_values[arg_count];
@@ -297,10 +391,10 @@ RPCServer::RPCServer() {
         JSValueRef value;
 
         if (name.is_number()) {
-            value = jsc::Object::get_property(m_context, m_objects[oid], name.get<unsigned int>());
+            value = jsc::Object::get_property(m_context, m_objects.get(m_context, oid), name.get<unsigned int>());
         }
         else {
-            value = jsc::Object::get_property(m_context, m_objects[oid], name.get<std::string>());
+            value = jsc::Object::get_property(m_context, m_objects.get(m_context, oid), name.get<std::string>());
         }
 
         return (json){{"result", serialize_json_value(value)}};
@@ -311,21 +405,40 @@ RPCServer::RPCServer() {
         JSValueRef value = deserialize_json_value(dict["value"]);
 
         if (name.is_number()) {
-            jsc::Object::set_property(m_context, m_objects[oid], name.get<unsigned int>(), value);
+            jsc::Object::set_property(m_context, m_objects.get(m_context, oid), name.get<unsigned int>(), value);
         }
         else {
-            jsc::Object::set_property(m_context, m_objects[oid], name.get<std::string>(), value);
+            jsc::Object::set_property(m_context, m_objects.get(m_context, oid), name.get<std::string>(), value);
         }
 
         return json::object();
     };
     m_requests["/dispose_object"] = [this](const json dict) {
         RPCObjectID oid = dict["id"].get<RPCObjectID>();
-        m_objects.erase(oid);
+        m_objects.release(oid);
+        return json::object();
+    };
+    m_requests["/batch"] = [this](const json dict) {
+        // All operations run in this one worker task, in order. The first one to throw fails the batch.
+        std::vector<json> results;
+        for (auto &operation : dict["operations"]) {
+            std::string name = "/" + operation["command"].get<std::string>();
+            if (name != "/call_method" && name != "/get_property" && name != "/set_property" && name != "/dispose_object") {
+                throw std::invalid_argument("Unsupported batch operation: " + name);
+            }
+
+            json response = m_requests[name](resolve_batch_references(operation, results));
+            results.push_back(response.value("result", json::object()));
+        }
+        return (json){{"result", results}};
+    };
+    m_requests["/set_prefetch"] = [this](const json dict) {
+        m_prefetch_properties = dict.value("properties", false);
+        m_prefetch_rows = dict.value("rows", size_t(0));
         return json::object();
     };
     m_requests["/get_all_users"] = [this](const json dict) {
-        JSObjectRef realm_constructor = m_session_id ? JSObjectRef(m_objects[m_session_id]) : NULL;
+        JSObjectRef realm_constructor = m_session_id ? m_objects.get(m_context, m_session_id) : NULL;
         if (!realm_constructor) {
             throw std::runtime_error("Realm constructor not found!");
         }
@@ -338,12 +451,7 @@ RPCServer::RPCServer() {
     };
     m_requests["/clear_test_state"] = [this](const json dict) {
         // The session ID points to the Realm constructor object, which should remain.
-        auto realm_constructor = m_objects[m_session_id];
-        m_objects.clear();
-
-        if (realm_constructor) {
-            m_objects.emplace(m_session_id, realm_constructor);
-        }
+        m_objects.clear(m_session_id);
 
         m_callbacks.clear();
         m_callback_ids.clear();
@@ -378,6 +486,13 @@ void RPCServer::run_callback(JSContextRef ctx, JSObjectRef function, JSObjectRef
     json arguments_json = server->serialize_json_value(arguments_array);
     json this_json = server->serialize_json_value(this_object);
 
+    // The result is delivered through this promise by deliver_callback_result().
+    std::future<json> result_future;
+    {
+        std::lock_guard<std::mutex> lock(server->m_pending_callbacks_mutex);
+        result_future = server->m_pending_callbacks[{callback_id, counter}].get_future();
+    }
+
     // The next task on the stack will instruct the JS to run this callback.
     // This captures references since it will be executed before exiting this function.
     server->m_worker.add_task([&]() -> json {
@@ -389,32 +504,21 @@ void RPCServer::run_callback(JSContextRef ctx, JSObjectRef function, JSObjectRef
         };
     });
 
-    // Wait for this callback call result to come off the result stack.
-    json callbackResult = nullptr;
-    while (callbackResult == nullptr) {
-        callbackResult = server->m_callback_results.pop_if([&](json result) {
-            auto resultCallbackId = result["callback"].get<u_int64_t>();
-            auto resultCallbackCounter = result["callback_call_counter"].get<u_int64_t>();
-            if (resultCallbackId == callback_id && resultCallbackCounter == counter) {
-                return true;
-            }
-            else {
-                return false;
-            }
-        });
-
-        if (callbackResult == nullptr) {
-            server->m_worker.try_run_task();
-        }
+    // Run the requests the callback makes while it runs, until its result has been delivered.
+    auto is_ready = [&] {
+        return result_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    };
+    server->m_worker.run_tasks_until(is_ready);
+    if (!is_ready()) {
+        std::lock_guard<std::mutex> lock(server->m_pending_callbacks_mutex);
+        server->m_pending_callbacks.erase({callback_id, counter});
+        throw jsc::Exception(ctx, "The RPC server was stopped while waiting for a callback");
     }
 
-    json results = callbackResult;
+    json results = result_future.get();
     json error = results["error"];
 
     auto resultCallbackId = results["callback"];
-    if (resultCallbackId.is_null()) {
-
-    }
     // The callback id should be identical!
     assert(callback_id == resultCallbackId.get<RPCObjectID>());
 
@@ -427,6 +531,22 @@ void RPCServer::run_callback(JSContextRef ctx, JSObjectRef function, JSObjectRef
 
 }
 
+void RPCServer::deliver_callback_result(json result) {
+    auto key = std::make_pair(result["callback"].get<RPCObjectID>(), result["callback_call_counter"].get<u_int64_t>());
+    {
+        std::lock_guard<std::mutex> lock(m_pending_callbacks_mutex);
+        auto it = m_pending_callbacks.find(key);
+        if (it == m_pending_callbacks.end()) {
+            return;
+        }
+        it->second.set_value(std::move(result));
+        m_pending_callbacks.erase(it);
+    }
+
+    // Wakes up run_callback() on the worker thread.
+    m_worker.wake();
+}
+
 json RPCServer::perform_request(std::string name, const json &args) {
     std::lock_guard<std::mutex> lock(m_request_mutex);
 
@@ -437,12 +557,10 @@ json RPCServer::perform_request(std::string name, const json &args) {
 
     // The callback_result message contains the return value (or exception) of a callback ran by run_callback().
     if (name == "/callback_result") {
-        json results(args);
-        m_callback_results.push_back(std::move(results));
+        deliver_callback_result(args);
     }
     else if (name == "/callback_poll_result") {
-        json results(args);
-        m_callback_results.push_back(std::move(results));
+        deliver_callback_result(args);
         return json::object();
     }
     else if (name == "/callbacks_poll") {
@@ -455,6 +573,10 @@ json RPCServer::perform_request(std::string name, const json &args) {
 
         m_worker.add_task([=] {
             try {
+                // Objects the client no longer refers to are released in batches along with other requests.
+                for (auto &id : args.value("releasedObjects", json::array())) {
+                    m_objects.release(id.get<RPCObjectID>());
+                }
                 return action(args);
             }
             catch (jsc::Exception ex) {
@@ -487,12 +609,157 @@ bool RPCServer::try_run_task() {
     return m_worker.try_run_task();
 }
 
-RPCObjectID RPCServer::store_object(JSObjectRef object) {
-    static RPCObjectID s_next_id = 1;
+bool RPCServer::is_binary_request(const std::string &name) const {
+    // The session is always created with JSON, as the protocol is negotiated there.
+    return m_binary_protocol && name != "/create_session";
+}
+
+std::string RPCServer::perform_encoded_request(const std::string &name, const std::string &body) {
+    if (is_binary_request(name)) {
+        return cbor::encode(perform_request(name, cbor::decode(body)));
+    }
+    return perform_request(name, json::parse(body)).dump();
+}
+
+RPCObjectID RPCServer::store_object(JSObjectRef object, RPCObjectTable::Materializer materializer) {
+    return m_objects.store(m_context, object, std::move(materializer));
+}
+
+RPCObjectID RPCObjectTable::store(JSContextRef ctx, JSObjectRef object, Materializer materializer) {
+    uint32_t index;
+    if (m_free_slots.empty()) {
+        index = uint32_t(m_entries.size());
+        m_entries.emplace_back();
+    }
+    else {
+        index = m_free_slots.front();
+        m_free_slots.pop_front();
+    }
+
+    Entry &entry = m_entries[index];
+    entry.in_use = true;
+    entry.materializer = std::move(materializer);
+    pin(ctx, index, object);
+
+    return (RPCObjectID(entry.generation) << 32) | (index + 1);
+}
+
+RPCObjectTable::Entry *RPCObjectTable::find(RPCObjectID id) {
+    uint64_t index = (id & 0xffffffff) - 1;
+    if (index >= m_entries.size()) {
+        return nullptr;
+    }
+    Entry &entry = m_entries[index];
+    return entry.in_use && entry.generation == uint32_t(id >> 32) ? &entry : nullptr;
+}
+
+JSObjectRef RPCObjectTable::get(JSContextRef ctx, RPCObjectID id) {
+    Entry *entry = find(id);
+    if (!entry) {
+        throw std::invalid_argument("Object has been released or never existed");
+    }
+
+    uint32_t index = uint32_t(entry - m_entries.data());
+    if (!entry->materializer) {
+        return *entry->object;
+    }
+    if (entry->object) {
+        // Mark this entry as the most recently used.
+        lru_unlink(index);
+        lru_push_front(index);
+        return *entry->object;
+    }
+
+    JSObjectRef object = entry->materializer(ctx);
+    pin(ctx, index, object);
+    return object;
+}
+
+void RPCObjectTable::release(RPCObjectID id) {
+    Entry *entry = find(id);
+    if (!entry) {
+        return;
+    }
+
+    uint32_t index = uint32_t(entry - m_entries.data());
+    if (entry->materializer && entry->object) {
+        lru_unlink(index);
+        m_pinned--;
+    }
+    entry->object = util::none;
+    entry->materializer = nullptr;
+    entry->in_use = false;
+    entry->generation = (entry->generation + 1) & max_generation;
+    m_free_slots.push_back(index);
+}
+
+void RPCObjectTable::keep_pinned(RPCObjectID id) {
+    // Only pinned entries can be kept, which the entries returned by get() are.
+    Entry *entry = find(id);
+    if (!entry || !entry->materializer || !entry->object) {
+        return;
+    }
+
+    lru_unlink(uint32_t(entry - m_entries.data()));
+    m_pinned--;
+    entry->materializer = nullptr;
+}
+
+void RPCObjectTable::clear(RPCObjectID keep) {
+    for (uint32_t index = 0; index < m_entries.size(); index++) {
+        RPCObjectID id = (RPCObjectID(m_entries[index].generation) << 32) | (index + 1);
+        if (m_entries[index].in_use && id != keep) {
+            release(id);
+        }
+    }
+}
+
+void RPCObjectTable::pin(JSContextRef ctx, uint32_t index, JSObjectRef object) {
+    Entry &entry = m_entries[index];
+    entry.object = js::Protected<JSObjectRef>(ctx, object);
+    if (!entry.materializer) {
+        return;
+    }
+
+    lru_push_front(index);
+    if (++m_pinned <= m_max_pinned) {
+        return;
+    }
+
+    // Unpin the least recently used entry, keeping what is needed to recreate it.
+    uint32_t evicted = m_lru_tail;
+    lru_unlink(evicted);
+    m_entries[evicted].object = util::none;
+    m_pinned--;
+}
+
+void RPCObjectTable::lru_unlink(uint32_t index) {
+    Entry &entry = m_entries[index];
+    if (entry.lru_prev != uint32_t(-1)) {
+        m_entries[entry.lru_prev].lru_next = entry.lru_next;
+    }
+    else {
+        m_lru_head = entry.lru_next;
+    }
+    if (entry.lru_next != uint32_t(-1)) {
+        m_entries[entry.lru_next].lru_prev = entry.lru_prev;
+    }
+    else {
+        m_lru_tail = entry.lru_prev;
+    }
+}
 
-    RPCObjectID next_id = s_next_id++;
-    m_objects.emplace(next_id, js::Protected<JSObjectRef>(m_context, object));
-    return next_id;
+void RPCObjectTable::lru_push_front(uint32_t index) {
+    Entry &entry = m_entries[index];
+    entry.lru_prev = uint32_t(-1);
+    entry.lru_next = m_lru_head;
+    if (m_lru_head != uint32_t(-1)) {
+        m_entries[m_lru_head].lru_prev = index;
+    }
+    else {
+        m_lru_tail = index;
+    }
+    m_lru_head = index;
 }
 
 json RPCServer::serialize_json_value(JSValueRef js_value) {
@@ -515,29 +782,53 @@ json RPCServer::serialize_json_value(JSValueRef js_value) {
 
     if (jsc::Object::is_instance<js::RealmObjectClass<jsc::Types>>(m_context, js_object)) {
         auto object = jsc::Object::get_internal<js::RealmObjectClass<jsc::Types>>(js_object);
-        return {
+
+        // The accessor keeps following its row, so the object can be recreated after it was unpinned.
+        auto materializer = [row = static_cast<realm::Object&>(*object)](JSContextRef ctx) {
+            return js::RealmObjectClass<jsc::Types>::create_instance(ctx, row);
+        };
+        json dict = {
             {"type", RealmObjectTypesObject},
-            {"id", store_object(js_object)},
+            {"id", store_object(js_object, std::move(materializer))},
             {"schema", serialize_object_schema(object->get_object_schema())}
         };
+        if (m_prefetch_properties) {
+            dict["values"] = serialize_primitive_properties(js_object, object->get_object_schema());
+        }
+        return dict;
     }
     else if (jsc::Object::is_instance<js::ListClass<jsc::Types>>(m_context, js_object)) {
         auto list = jsc::Object::get_internal<js::ListClass<jsc::Types>>(js_object);
-        return {
+        json dict = {
             {"type", RealmObjectTypesList},
             {"id", store_object(js_object)},
             {"size", list->size()},
             {"schema", get_type(*list)},
          };
+        if (m_prefetch_rows) {
+            dict["rows"] = serialize_leading_rows(js_object, list->size());
+        }
+        return dict;
     }
     else if (jsc::Object::is_instance<js::ResultsClass<jsc::Types>>(m_context, js_object)) {
         auto results = jsc::Object::get_internal<js::ResultsClass<jsc::Types>>(js_object);
-        return {
+        json dict = {
             {"type", RealmObjectTypesResults},
             {"id", store_object(js_object)},
             {"size", results->size()},
             {"schema", get_type(*results)},
         };
+        if (m_prefetch_rows) {
+            dict["rows"] = serialize_leading_rows(js_object, results->size());
+        }
+        return dict;
+    }
+    else if (jsc::Object::is_instance<js::ResultsWindowClass<jsc::Types>>(m_context, js_object)) {
+        // The rows are read through the window on demand, as it moves over the results.
+        return {
+            {"type", RealmObjectTypesResultsWindow},
+            {"id", store_object(js_object)},
+        };
     }
     else if (jsc::Object::is_instance<js::RealmClass<jsc::Types>>(m_context, js_object)) {
         return {
@@ -591,6 +882,13 @@ json RPCServer::serialize_json_value(JSValueRef js_value) {
     }
     else if (jsc::Value::is_binary(m_context, js_object)) {
         auto data = jsc::Value::to_binary(m_context, js_object);
+        if (m_binary_protocol) {
+            // Sent as a raw CBOR byte string.
+            return {
+                {"type", RealmObjectTypesData},
+                {"value", std::string(data.data(), data.size())},
+            };
+        }
         return {
             {"type", RealmObjectTypesData},
             {"value", base64_encode((unsigned char *)data.data(), data.size())},
@@ -633,10 +931,30 @@ json RPCServer::serialize_json_value(JSValueRef js_value) {
     assert(0);
 }
 
+json RPCServer::serialize_primitive_properties(JSObjectRef js_object, const ObjectSchema &object_schema) {
+    // Links and lists are left for the client to request, as they would each store another object.
+    json values = json::object();
+    for (auto &prop : object_schema.persisted_properties) {
+        if (is_array(prop.type) || prop.type == PropertyType::Object) {
+            continue;
+        }
+        values[prop.name] = serialize_json_value(jsc::Object::get_property(m_context, js_object, prop.name));
+    }
+    return values;
+}
+
+json RPCServer::serialize_leading_rows(JSObjectRef js_collection, size_t size) {
+    std::vector<json> rows;
+    for (size_t i = 0, count = std::min(size, m_prefetch_rows); i < count; i++) {
+        rows.push_back(serialize_json_value(jsc::Object::get_property(m_context, js_collection, uint32_t(i))));
+    }
+    return rows;
+}
+
 JSValueRef RPCServer::deserialize_json_value(const json dict) {
     json oid = dict.value("id", json());
     if (oid.is_number()) {
-        return m_objects[oid.get<RPCObjectID>()];
+        return m_objects.get(m_context, oid.get<RPCObjectID>());
     }
 
     json value = dict.value("value", json());
@@ -672,7 +990,10 @@ JSValueRef RPCServer::deserialize_json_value(const json dict) {
         }
         else if (type_string == RealmObjectTypesData) {
             std::string bytes;
-            if (!base64_decode(value.get<std::string>(), &bytes)) {
+            if (m_binary_protocol) {
+                bytes = value.get<std::string>();
+            }
+            else if (!base64_decode(value.get<std::string>(), &bytes)) {
                 throw std::runtime_error("Failed to decode base64 encoded data");
             }
             return jsc::Value::from_binary(m_context, realm::BinaryData(bytes.data(), bytes.size()));
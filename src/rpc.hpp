@@ -18,9 +18,18 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <future>
+#include <map>
+#include <mutex>
 #include <thread>
+#include <utility>
+#include <vector>
+
+#include <realm/util/optional.hpp>
 
 #include "concurrent_deque.hpp"
 #include "json.hpp"
@@ -50,14 +59,73 @@ class RPCWorker {
     json try_pop_task_result();
     bool should_stop();
 
+    // Runs tasks as they are added until `done` returns true or the worker is stopped. The thread
+    // sleeps in between and `done` is checked again on every call to wake().
+    void run_tasks_until(std::function<bool()> done);
+    void wake();
+
   private:
-    bool m_stop = false;
+    std::atomic<bool> m_stop{false};
 #if __APPLE__
     std::thread m_thread;
     CFRunLoopRef m_loop;
 #endif
-    ConcurrentDeque<std::packaged_task<json()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<std::packaged_task<json()>> m_tasks;
     ConcurrentDeque<std::future<json>> m_futures;
+
+    void run_task(std::packaged_task<json()> task);
+};
+
+// The objects handed out to the client. Entries live in a slab indexed by the low 32 bits of their
+// id; the high bits hold the generation of the slot so that ids of released entries are not resolved
+// to a later occupant. Generations wrap at 21 bits, which keeps ids exactly representable as
+// JavaScript numbers, and released slots are reused in FIFO order so that a generation only comes
+// around again after 2^21 reuses of every free slot. Entries which can be recreated (Realm objects) are unpinned in
+// least recently used order once there are more than `max_pinned` of them, and recreated from their
+// row the next time the client refers to them.
+class RPCObjectTable {
+  public:
+    using Materializer = std::function<JSObjectRef(JSContextRef)>;
+
+    RPCObjectTable(size_t max_pinned = 10000) : m_max_pinned(max_pinned) {}
+
+    RPCObjectID store(JSContextRef ctx, JSObjectRef object, Materializer materializer = nullptr);
+    JSObjectRef get(JSContextRef ctx, RPCObjectID id);
+    void release(RPCObjectID id);
+
+    // Stops the entry from being unpinned, e.g. because its object holds listeners which would be
+    // lost if it were recreated.
+    void keep_pinned(RPCObjectID id);
+
+    // Releases all entries except `keep`.
+    void clear(RPCObjectID keep = 0);
+
+  private:
+    // Ids are at most 2^53 - 1: 21 bits of generation above the 32 bits of index.
+    static constexpr uint32_t max_generation = (1 << 21) - 1;
+
+    struct Entry {
+        uint32_t generation = 0;
+        bool in_use = false;
+        util::Optional<js::Protected<JSObjectRef>> object;
+        Materializer materializer;
+        uint32_t lru_prev;
+        uint32_t lru_next;
+    };
+
+    std::vector<Entry> m_entries;
+    std::deque<uint32_t> m_free_slots;
+    size_t m_max_pinned;
+    size_t m_pinned = 0;
+    uint32_t m_lru_head = uint32_t(-1);
+    uint32_t m_lru_tail = uint32_t(-1);
+
+    Entry *find(RPCObjectID id);
+    void lru_unlink(uint32_t index);
+    void lru_push_front(uint32_t index);
+    void pin(JSContextRef ctx, uint32_t index, JSObjectRef object);
 };
 
 class RPCServer {
@@ -67,27 +135,42 @@ class RPCServer {
     json perform_request(std::string name, const json &args);
     bool try_run_task();
 
+    // Requests and responses of a session which negotiated the binary protocol in /create_session
+    // are CBOR encoded. Everything else is JSON.
+    bool is_binary_request(const std::string &name) const;
+    std::string perform_encoded_request(const std::string &name, const std::string &body);
+
 
   private:
     JSGlobalContextRef m_context;
     std::mutex m_request_mutex;
     std::map<std::string, RPCRequest> m_requests;
-    std::map<RPCObjectID, js::Protected<JSObjectRef>> m_objects;
+    RPCObjectTable m_objects;
     std::map<RPCObjectID, js::Protected<JSObjectRef>> m_callbacks;
     // The key here is the same as the value in m_callbacks. We use the raw pointer as a key here,
     // because protecting the value in m_callbacks pins the function object and prevents it from being moved
     // by the garbage collector upon compaction.
     std::map<JSObjectRef, RPCObjectID> m_callback_ids;
-    ConcurrentDeque<json> m_callback_results;
+    // Callbacks waiting in run_callback() for the client to send back their result.
+    std::mutex m_pending_callbacks_mutex;
+    std::map<std::pair<RPCObjectID, u_int64_t>, std::promise<json>> m_pending_callbacks;
     RPCObjectID m_session_id;
+    std::atomic<bool> m_binary_protocol{false};
+    // Set through /set_prefetch: whether objects are sent with their primitive property values, and
+    // how many leading rows are sent along with lists and results.
+    bool m_prefetch_properties = false;
+    size_t m_prefetch_rows = 0;
     RPCWorker m_worker;
     u_int64_t m_callback_call_counter;
 
     static void run_callback(JSContextRef, JSObjectRef, JSObjectRef, size_t, const JSValueRef[], jsc::ReturnValue &);
+    void deliver_callback_result(json result);
 
-    RPCObjectID store_object(JSObjectRef object);
+    RPCObjectID store_object(JSObjectRef object, RPCObjectTable::Materializer materializer = nullptr);
 
     json serialize_json_value(JSValueRef value);
+    json serialize_primitive_properties(JSObjectRef object, const ObjectSchema &object_schema);
+    json serialize_leading_rows(JSObjectRef collection, size_t size);
     JSValueRef deserialize_json_value(const json dict);
 };
 
@@ -0,0 +1,303 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2018 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "json.hpp"
+
+namespace realm {
+namespace rpc {
+namespace cbor {
+
+// CBOR (RFC 7049) framing for RPC messages. The bundled JSON library has no binary type, so raw
+// bytes are kept in strings: the "value" of a {"type": "data"} dictionary is written as a CBOR
+// byte string, and byte strings are read back into strings holding the raw bytes.
+
+using json = nlohmann::json;
+
+namespace detail {
+
+enum MajorType : uint8_t {
+    UnsignedInteger = 0,
+    NegativeInteger = 1,
+    ByteString = 2,
+    TextString = 3,
+    Array = 4,
+    Map = 5,
+    Simple = 7,
+};
+
+inline void write_big_endian(std::string &out, uint64_t value, size_t bytes) {
+    for (size_t i = bytes; i--;) {
+        out.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+    }
+}
+
+inline void write_head(std::string &out, MajorType major, uint64_t value) {
+    uint8_t initial = static_cast<uint8_t>(major << 5);
+    if (value < 24) {
+        out.push_back(static_cast<char>(initial | value));
+    }
+    else if (value <= 0xff) {
+        out.push_back(static_cast<char>(initial | 24));
+        write_big_endian(out, value, 1);
+    }
+    else if (value <= 0xffff) {
+        out.push_back(static_cast<char>(initial | 25));
+        write_big_endian(out, value, 2);
+    }
+    else if (value <= 0xffffffff) {
+        out.push_back(static_cast<char>(initial | 26));
+        write_big_endian(out, value, 4);
+    }
+    else {
+        out.push_back(static_cast<char>(initial | 27));
+        write_big_endian(out, value, 8);
+    }
+}
+
+inline void write_string(std::string &out, MajorType major, const std::string &string) {
+    write_head(out, major, string.size());
+    out.append(string);
+}
+
+inline void write_value(std::string &out, const json &value) {
+    switch (value.type()) {
+        case json::value_t::null:
+        case json::value_t::discarded:
+            out.push_back(static_cast<char>(0xf6));
+            break;
+        case json::value_t::boolean:
+            out.push_back(static_cast<char>(value.get<bool>() ? 0xf5 : 0xf4));
+            break;
+        case json::value_t::number_integer: {
+            int64_t number = value.get<int64_t>();
+            if (number >= 0) {
+                write_head(out, UnsignedInteger, static_cast<uint64_t>(number));
+            }
+            else {
+                write_head(out, NegativeInteger, static_cast<uint64_t>(-(number + 1)));
+            }
+            break;
+        }
+        case json::value_t::number_unsigned:
+            write_head(out, UnsignedInteger, value.get<uint64_t>());
+            break;
+        case json::value_t::number_float: {
+            double number = value.get<double>();
+            uint64_t bits;
+            std::memcpy(&bits, &number, sizeof(bits));
+            out.push_back(static_cast<char>(0xfb));
+            write_big_endian(out, bits, 8);
+            break;
+        }
+        case json::value_t::string:
+            write_string(out, TextString, value.get_ref<const json::string_t &>());
+            break;
+        case json::value_t::array:
+            write_head(out, Array, value.size());
+            for (auto &item : value) {
+                write_value(out, item);
+            }
+            break;
+        case json::value_t::object: {
+            auto type = value.find("type");
+            bool is_data = type != value.end() && *type == "data";
+
+            write_head(out, Map, value.size());
+            for (auto it = value.begin(); it != value.end(); ++it) {
+                write_string(out, TextString, it.key());
+                if (is_data && it.key() == "value" && it.value().is_string()) {
+                    write_string(out, ByteString, it.value().get_ref<const json::string_t &>());
+                }
+                else {
+                    write_value(out, it.value());
+                }
+            }
+            break;
+        }
+    }
+}
+
+// Arrays and maps nested deeper than this are rejected, so that a malicious request cannot exhaust the
+// stack of the reader. RPC messages are nested a few levels deep.
+constexpr size_t max_depth = 128;
+
+class Reader {
+  public:
+    Reader(const std::string &data) : m_data(data) {}
+
+    json read_value(size_t depth = 0) {
+        uint8_t initial = read_byte();
+        auto major = static_cast<MajorType>(initial >> 5);
+        uint8_t info = initial & 0x1f;
+
+        if (major == Simple) {
+            return read_simple(info);
+        }
+
+        uint64_t argument = read_argument(info);
+        switch (major) {
+            case UnsignedInteger:
+                return json(argument);
+            case NegativeInteger:
+                return json(-1 - static_cast<int64_t>(argument));
+            case ByteString:
+            case TextString:
+                return json(read_bytes(argument));
+            case Array: {
+                check_depth(depth);
+                json array = json::array();
+                for (uint64_t i = 0; i < argument; i++) {
+                    array.push_back(read_value(depth + 1));
+                }
+                return array;
+            }
+            case Map: {
+                check_depth(depth);
+                json object = json::object();
+                for (uint64_t i = 0; i < argument; i++) {
+                    json key = read_value(depth + 1);
+                    if (!key.is_string()) {
+                        throw std::invalid_argument("CBOR map keys must be strings");
+                    }
+                    object[key.get<std::string>()] = read_value(depth + 1);
+                }
+                return object;
+            }
+            default:
+                throw std::invalid_argument("Unsupported CBOR type");
+        }
+    }
+
+    bool at_end() const {
+        return m_position == m_data.size();
+    }
+
+  private:
+    const std::string &m_data;
+    size_t m_position = 0;
+
+    static void check_depth(size_t depth) {
+        if (depth >= max_depth) {
+            throw std::invalid_argument("CBOR input is nested too deeply");
+        }
+    }
+
+    uint8_t read_byte() {
+        if (m_position >= m_data.size()) {
+            throw std::invalid_argument("Unexpected end of CBOR input");
+        }
+        return static_cast<uint8_t>(m_data[m_position++]);
+    }
+
+    uint64_t read_big_endian(size_t bytes) {
+        uint64_t value = 0;
+        for (size_t i = 0; i < bytes; i++) {
+            value = (value << 8) | read_byte();
+        }
+        return value;
+    }
+
+    uint64_t read_argument(uint8_t info) {
+        if (info < 24) {
+            return info;
+        }
+        switch (info) {
+            case 24: return read_big_endian(1);
+            case 25: return read_big_endian(2);
+            case 26: return read_big_endian(4);
+            case 27: return read_big_endian(8);
+            default: throw std::invalid_argument("Indefinite length CBOR items are not supported");
+        }
+    }
+
+    std::string read_bytes(uint64_t length) {
+        if (length > m_data.size() - m_position) {
+            throw std::invalid_argument("Unexpected end of CBOR input");
+        }
+        std::string bytes = m_data.substr(m_position, static_cast<size_t>(length));
+        m_position += static_cast<size_t>(length);
+        return bytes;
+    }
+
+    json read_simple(uint8_t info) {
+        switch (info) {
+            case 20: return json(false);
+            case 21: return json(true);
+            case 22:
+            case 23: return json(nullptr);
+            case 25: {
+                uint16_t half = static_cast<uint16_t>(read_big_endian(2));
+                int exponent = (half >> 10) & 0x1f;
+                int mantissa = half & 0x3ff;
+                double value;
+                if (exponent == 0) {
+                    value = std::ldexp(mantissa, -24);
+                }
+                else if (exponent != 31) {
+                    value = std::ldexp(mantissa + 1024, exponent - 25);
+                }
+                else {
+                    value = mantissa == 0 ? INFINITY : NAN;
+                }
+                return json(half & 0x8000 ? -value : value);
+            }
+            case 26: {
+                uint32_t bits = static_cast<uint32_t>(read_big_endian(4));
+                float value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return json(static_cast<double>(value));
+            }
+            case 27: {
+                uint64_t bits = read_big_endian(8);
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return json(value);
+            }
+            default:
+                throw std::invalid_argument("Unsupported CBOR simple value");
+        }
+    }
+};
+
+} // detail
+
+inline std::string encode(const json &value) {
+    std::string out;
+    detail::write_value(out, value);
+    return out;
+}
+
+inline json decode(const std::string &data) {
+    detail::Reader reader(data);
+    json value = reader.read_value();
+    if (!reader.at_end()) {
+        throw std::invalid_argument("Unexpected data after CBOR item");
+    }
+    return value;
+}
+
+} // cbor
+} // rpc
+} // realm
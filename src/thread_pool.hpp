@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2018 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace realm {
+namespace js {
+
+// A fixed number of threads running tasks in the order they were submitted. The threads are
+// started with the pool and wait for work for the lifetime of the process.
+class ThreadPool {
+  public:
+    // Shared by every JS thread, with a thread per core.
+    static ThreadPool& shared() {
+        // Never destroyed, so that exiting the process does not wait for the threads.
+        static ThreadPool* pool = new ThreadPool(std::max(1u, std::thread::hardware_concurrency()));
+        return *pool;
+    }
+
+    explicit ThreadPool(size_t size) : m_size(size) {
+        for (size_t i = 0; i < size; ++i) {
+            std::thread([this] { run(); }).detach();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const {
+        return m_size;
+    }
+
+    // Tasks must not wait for other tasks of the pool, which could all be waiting themselves.
+    template<typename Function>
+    std::future<typename std::result_of<Function()>::type> submit(Function&& function) {
+        using Result = typename std::result_of<Function()>::type;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(function));
+        auto future = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push_back([task] { (*task)(); });
+        }
+        m_condition.notify_one();
+        return future;
+    }
+
+  private:
+    const size_t m_size;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<std::function<void()>> m_tasks;
+
+    void run() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this] { return !m_tasks.empty(); });
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+            task();
+        }
+    }
+};
+
+} // js
+} // realm
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2018 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#import <XCTest/XCTest.h>
+
+#include <string>
+
+#include "rpc_cbor.hpp"
+
+using namespace realm::rpc;
+
+// Tests of the CBOR codec used by the Chrome debugging RPC server.
+@interface RealmJSCBORTests : XCTestCase
+@end
+
+@implementation RealmJSCBORTests
+
+- (void)testRoundTrip {
+    cbor::json value = {
+        {"type", "object"},
+        {"id", 12},
+        {"negative", -100},
+        {"large", 4294967296ULL},
+        {"double", 0.5},
+        {"string", "ünïcødé"},
+        {"list", {1, "two", nullptr, {true, false}, {{"nested", {{"deeper", {3.5}}}}}}},
+        {"empty", cbor::json::object()},
+        {"emptyList", cbor::json::array()},
+    };
+    XCTAssertTrue(cbor::decode(cbor::encode(value)) == value);
+}
+
+- (void)testEncoding {
+    // Examples from appendix A of RFC 7049.
+    XCTAssertTrue(cbor::encode(0) == std::string("\x00", 1));
+    XCTAssertTrue(cbor::encode(24) == "\x18\x18");
+    XCTAssertTrue(cbor::encode(1000) == "\x19\x03\xe8");
+    XCTAssertTrue(cbor::encode(-100) == "\x38\x63");
+    XCTAssertTrue(cbor::encode("IETF") == "\x64IETF");
+    XCTAssertTrue(cbor::encode(cbor::json::parse("[1, [2, 3]]")) == "\x82\x01\x82\x02\x03");
+
+    XCTAssertTrue(cbor::decode(std::string("\xf9\x3c\x00", 3)) == 1.0);
+    XCTAssertTrue(cbor::decode(std::string("\xf9\xc4\x00", 3)) == -4.0);
+    XCTAssertTrue(cbor::decode(std::string("\xfa\x47\xc3\x50\x00", 5)) == 100000.0);
+}
+
+- (void)testBinaryData {
+    std::string bytes("\x00\x01\xff", 3);
+    cbor::json value = {{"type", "data"}, {"value", bytes}};
+    std::string encoded = cbor::encode(value);
+
+    // The value of a data dictionary is written as a byte string rather than a text string.
+    XCTAssertNotEqual(encoded.find(std::string("\x43", 1) + bytes), std::string::npos);
+    XCTAssertTrue(cbor::decode(encoded) == value);
+}
+
+- (void)testInvalidInput {
+    XCTAssertThrows(cbor::decode(""));
+    XCTAssertThrows(cbor::decode("\x82\x01"));
+    XCTAssertThrows(cbor::decode(std::string("\x01\x02", 2)));
+    XCTAssertThrows(cbor::decode("\x9f\x01\xff"));
+    XCTAssertThrows(cbor::decode(std::string("\xa1\x01\x01", 3)));
+}
+
+- (void)testNestingLimit {
+    std::string nested(cbor::detail::max_depth - 1, '\x81');
+    nested.push_back('\x00');
+    XCTAssertNoThrow(cbor::decode(nested));
+
+    std::string tooDeep(cbor::detail::max_depth + 1, '\x81');
+    tooDeep.push_back('\x00');
+    XCTAssertThrows(cbor::decode(tooDeep));
+
+    std::string maps;
+    for (size_t i = 0; i <= cbor::detail::max_depth; i++) {
+        maps += "\xa1\x61k";
+    }
+    maps.push_back('\x00');
+    XCTAssertThrows(cbor::decode(maps));
+}
+
+@end
@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2018 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+'use strict';
+
+const TestCase = require('./asserts');
+const cbor = require('realm/lib/browser/cbor');
+
+function roundTrip(value) {
+    return cbor.decode(cbor.encode(value));
+}
+
+function bytes(...values) {
+    return new Uint8Array(values);
+}
+
+module.exports = {
+    testCBORScalars: function() {
+        const values = [0, 1, 23, 24, 255, 256, 65535, 65536, 4294967295, 4294967296, Number.MAX_SAFE_INTEGER,
+                        -1, -24, -25, -256, -257, -4294967297, Number.MIN_SAFE_INTEGER,
+                        0.5, -1.25, 1e300, Infinity, -Infinity, true, false, null, '', 'abc', 'ünïcødé ✓ 𝄞'];
+        for (const value of values) {
+            TestCase.assertEqual(roundTrip(value), value, `round trip of ${value}`);
+        }
+        TestCase.assertTrue(isNaN(roundTrip(NaN)));
+    },
+
+    testCBOREncoding: function() {
+        // Examples from appendix A of RFC 7049.
+        TestCase.assertArraysEqual(Array.from(cbor.encode(0)), [0x00]);
+        TestCase.assertArraysEqual(Array.from(cbor.encode(24)), [0x18, 0x18]);
+        TestCase.assertArraysEqual(Array.from(cbor.encode(1000)), [0x19, 0x03, 0xe8]);
+        TestCase.assertArraysEqual(Array.from(cbor.encode(-100)), [0x38, 0x63]);
+        TestCase.assertArraysEqual(Array.from(cbor.encode('IETF')), [0x64, 0x49, 0x45, 0x54, 0x46]);
+        TestCase.assertArraysEqual(Array.from(cbor.encode([1, [2, 3]])), [0x82, 0x01, 0x82, 0x02, 0x03]);
+        TestCase.assertArraysEqual(Array.from(cbor.encode({a: 1})), [0xa1, 0x61, 0x61, 0x01]);
+
+        // Half and single precision floats are read, although they are never written.
+        TestCase.assertEqual(cbor.decode(bytes(0xf9, 0x3c, 0x00)), 1);
+        TestCase.assertEqual(cbor.decode(bytes(0xf9, 0xc4, 0x00)), -4);
+        TestCase.assertEqual(cbor.decode(bytes(0xf9, 0x7c, 0x00)), Infinity);
+        TestCase.assertEqual(cbor.decode(bytes(0xfa, 0x47, 0xc3, 0x50, 0x00)), 100000);
+    },
+
+    testCBORContainers: function() {
+        const value = {
+            type: 'object',
+            id: 12,
+            list: [1, 'two', null, [true, false], {nested: {deeper: [3.5]}}],
+            empty: {},
+            emptyList: [],
+        };
+        const result = roundTrip(value);
+        TestCase.assertEqual(JSON.stringify(result), JSON.stringify(value));
+
+        // Undefined properties are left out, as in JSON.
+        TestCase.assertEqual(JSON.stringify(roundTrip({a: 1, b: undefined})), '{"a":1}');
+    },
+
+    testCBORBinary: function() {
+        const data = new Uint8Array(300);
+        for (let i = 0; i < data.length; i++) {
+            data[i] = i & 0xff;
+        }
+        const result = roundTrip({type: 'data', value: data.buffer});
+        TestCase.assertEqual(result.type, 'data');
+        TestCase.assertTrue(result.value instanceof ArrayBuffer);
+        TestCase.assertArraysEqual(Array.from(new Uint8Array(result.value)), Array.from(data));
+
+        const view = roundTrip(data.subarray(10, 20));
+        TestCase.assertArraysEqual(Array.from(new Uint8Array(view)), Array.from(data.subarray(10, 20)));
+    },
+
+    testCBORInvalidInput: function() {
+        TestCase.assertThrowsContaining(() => cbor.decode(bytes()), 'Unexpected end of CBOR input');
+        TestCase.assertThrowsContaining(() => cbor.decode(bytes(0x82, 0x01)), 'Unexpected end of CBOR input');
+        TestCase.assertThrowsContaining(() => cbor.decode(bytes(0x01, 0x02)), 'Unexpected data after CBOR item');
+
+        const nested = new Uint8Array(200).fill(0x81);
+        TestCase.assertThrowsContaining(() => cbor.decode(nested), 'CBOR input is nested too deeply');
+
+        let value = 0;
+        for (let i = 0; i < 100; i++) {
+            value = [value];
+        }
+        TestCase.assertEqual(JSON.stringify(roundTrip(value)), JSON.stringify(value));
+    },
+};
@@ -49,6 +49,7 @@ var TESTS = {
     MigrationTests: require('./migration-tests'),
     EncryptionTests: require('./encryption-tests'),
     ObjectIDTests: require('./object-id-tests'),
+    ShardedTests: require('./sharded-tests'),
     // Garbagecollectiontests: require('./garbage-collection'),
 };
 
@@ -63,11 +64,41 @@ if (global.enableSyncTests) {
     }
 }
 
+// The Chrome debugging RPC codec is an ES module, which is only bundled by React Native
+if (!isNodeProcess) {
+    TESTS.CBORTests = require('./cbor-tests');
+}
+
 // If on node, run the async tests
 if (isNodeProcess && process.platform !== 'win32') {
     TESTS.AsyncTests = node_require('./async-tests');
 }
 
+// If worker threads are available, check that Realms can be used from them
+if (isNodeProcess) {
+    let hasWorkerThreads = false;
+    try {
+        node_require('worker_threads');
+        hasWorkerThreads = true;
+    }
+    catch (e) {
+        // Node.js before 10.5, or without --experimental-worker
+    }
+    if (hasWorkerThreads) {
+        TESTS.WorkerThreadsTests = node_require('./worker-threads-tests');
+    }
+}
+
+// Weak listeners are only released by the garbage collector, which the tests can trigger on node
+if (isNodeProcess) {
+    TESTS.WeakListenerTests = node_require('./weak-listener-tests');
+}
+
+// The global notifier is only available on node
+if (isNodeProcess) {
+    TESTS.NotifierTests = node_require('./notifier-tests');
+}
+
 var SPECIAL_METHODS = {
     beforeEach: true,
     afterEach: true,
@@ -0,0 +1,279 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2018 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/* eslint-env es6, node */
+
+'use strict';
+
+const childProcess = require('child_process');
+const EventEmitter = require('events');
+const notifier = require('realm/lib/notifier');
+const Worker = require('realm/lib/worker');
+const TestCase = require('./asserts');
+
+// Stands in for Realm.Sync, with a native notifier whose changes are pushed by the test.
+function createSync() {
+    const Sync = {
+        queue: [],
+        _setListenerDirectory() {},
+        _createNotifier(server, user, callback) {
+            Sync.callback = callback;
+            return {
+                start() {
+                    if (!Sync.started) {
+                        Sync.started = true;
+                        setImmediate(() => callback('downloadComplete'));
+                    }
+                },
+                close() {},
+                next() {
+                    return Sync.queue.shift();
+                },
+            };
+        },
+        push(path, event) {
+            const change = {path, event: event || 'onchange', isEmpty: false, closed: false};
+            change.close = () => { change.closed = true; };
+            change.serialize = () => path;
+            Sync.queue.push(change);
+            Sync.callback('change');
+            return change;
+        },
+    };
+    notifier({Sync});
+    return Sync;
+}
+
+// Counts the paths each listener regex is tested against.
+function countRegexTests(body) {
+    const test = RegExp.prototype.test;
+    const counts = {};
+    RegExp.prototype.test = function(string) {
+        const key = `${this.source} ${string}`;
+        counts[key] = (counts[key] || 0) + 1;
+        return test.call(this, string);
+    };
+    try {
+        body(counts);
+    }
+    finally {
+        RegExp.prototype.test = test;
+    }
+}
+
+// Runs `body` with a Worker whose child processes are stubs recording the messages sent to them. A
+// child finishes its current message when the test calls `reply()`.
+function withStubWorker(options, body) {
+    const fork = childProcess.fork;
+    const children = [];
+    childProcess.fork = () => {
+        const child = new EventEmitter();
+        child.pid = children.length;
+        child.sent = [];
+        child.send = (message) => child.sent.push(message);
+        child.reply = () => child.emit('message', {});
+        children.push(child);
+        return child;
+    };
+    const restore = () => { childProcess.fork = fork; };
+    return Promise.resolve()
+        .then(() => body(new Worker('stub-module', options), children))
+        .then(restore, (e) => {
+            restore();
+            throw e;
+        });
+}
+
+function createChange(path) {
+    return {path, released: 0, serialize: () => path, release() { ++this.released; }};
+}
+
+// The paths of the changes sent to a stub child.
+function sentPaths(child) {
+    return child.sent.filter(m => m.message === 'change').map(m => m.change);
+}
+
+module.exports = {
+    testNotifierMatchesEachPathOnce: function() {
+        const Sync = createSync();
+        const received = [];
+        const onchange = (change) => { received.push(change.path); };
+
+        return Sync.addListener('realm://server', {}, '^/a', 'change', onchange)
+            .then(() => {
+                countRegexTests((counts) => {
+                    Sync.callback('available', '/a/1');
+                    Sync.push('/a/1');
+                    Sync.push('/a/1');
+                    const unmatched = Sync.push('/b/1');
+                    Sync.push('/b/1');
+
+                    TestCase.assertEqual(counts['^\\/a /a/1'], 1);
+                    TestCase.assertEqual(counts['^\\/a /b/1'], 1);
+                    TestCase.assertTrue(unmatched.closed);
+                });
+                TestCase.assertArraysEqual(received, ['/a/1', '/a/1']);
+            })
+            .then(() => Sync.removeAllListeners());
+    },
+
+    testNotifierInvalidatesMatchesOnListenerChanges: function() {
+        const Sync = createSync();
+        const first = [];
+        const second = [];
+        const onFirst = (change) => { first.push(change.path); };
+        const onSecond = (change) => { second.push(change.path); };
+
+        return Sync.addListener('realm://server', {}, '^/a', 'change', onFirst)
+            .then(() => {
+                Sync.push('/a/1');
+                return Sync.addListener('realm://server', {}, '/1$', 'change', onSecond);
+            })
+            .then(() => {
+                countRegexTests((counts) => {
+                    // Adding a listener retests the path against every listener.
+                    Sync.push('/a/1');
+                    TestCase.assertEqual(counts['^\\/a /a/1'], 1);
+                    TestCase.assertEqual(counts['\\/1$ /a/1'], 1);
+                });
+                return Sync.removeListener('/1$', 'change', onSecond);
+            })
+            .then(() => {
+                countRegexTests((counts) => {
+                    // Removing one does too, and the removed listener gets nothing more.
+                    Sync.push('/a/1');
+                    TestCase.assertEqual(counts['^\\/a /a/1'], 1);
+                    TestCase.assertUndefined(counts['\\/1$ /a/1']);
+
+                    // A deleted path is forgotten, so a Realm created at the same path is matched again.
+                    Sync.push('/a/1', 'ondelete');
+                    Sync.push('/a/1');
+                    TestCase.assertEqual(counts['^\\/a /a/1'], 2);
+                });
+                TestCase.assertArraysEqual(first, ['/a/1', '/a/1', '/a/1', '/a/1']);
+                TestCase.assertArraysEqual(second, ['/a/1']);
+            })
+            .then(() => Sync.removeAllListeners());
+    },
+
+    testWorkerPinsPathsToChildren: function() {
+        return withStubWorker({maxWorkers: 2}, (worker, children) => {
+            worker.onchange(createChange('/a'));
+            worker.onchange(createChange('/b'));
+            worker.onchange(createChange('/a'));
+
+            const [first, second] = children;
+            TestCase.assertEqual(children.length, 2);
+            TestCase.assertArraysEqual(sentPaths(first), ['/a']);
+            TestCase.assertArraysEqual(sentPaths(second), ['/b']);
+
+            // The second change to /a waits for the first rather than going to the idle child.
+            second.reply();
+            TestCase.assertArraysEqual(sentPaths(second), ['/b']);
+            first.reply();
+            TestCase.assertArraysEqual(sentPaths(first), ['/a', '/a']);
+            first.reply();
+
+            const metrics = worker.metrics().children;
+            TestCase.assertArraysEqual(metrics.map(c => c.paths), [1, 1]);
+            TestCase.assertArraysEqual(metrics.map(c => c.processed), [2, 1]);
+
+            // A deleted path is released once its delete event has been processed.
+            const deleted = createChange('/a');
+            worker.ondelete(deleted);
+            first.reply();
+            TestCase.assertEqual(deleted.released, 1);
+            TestCase.assertEqual(worker.metrics().children[0].paths, 0);
+        });
+    },
+
+    testWorkerBackpressure: function() {
+        const Sync = createSync();
+        return withStubWorker({maxWorkers: 1, maxQueueDepth: 1}, (worker, children) => {
+            const [child] = children;
+            return Sync.addListener('realm://server', {}, '.*', worker)
+                .then(() => {
+                    const changes = [Sync.push('/a'), Sync.push('/a'), Sync.push('/a')];
+
+                    // The first change is being processed and the second fills the queue, so the third
+                    // is left with the native notifier.
+                    TestCase.assertTrue(worker.isFull);
+                    TestCase.assertEqual(Sync.queue.length, 1);
+                    TestCase.assertEqual(worker.metrics().pendingChanges, 1);
+                    TestCase.assertArraysEqual(sentPaths(child), ['/a']);
+
+                    // Finishing the first change drains the queue, which reads the third change.
+                    child.reply();
+                    TestCase.assertTrue(changes[0].closed);
+                    TestCase.assertEqual(Sync.queue.length, 0);
+                    TestCase.assertEqual(worker.metrics().pendingChanges, 0);
+                    TestCase.assertArraysEqual(sentPaths(child), ['/a', '/a']);
+
+                    child.reply();
+                    child.reply();
+                    TestCase.assertTrue(changes.every(c => c.closed));
+                    TestCase.assertFalse(worker.isFull);
+
+                    // Changes held back when the listeners are removed are closed rather than leaked.
+                    Sync.push('/a');
+                    Sync.push('/a');
+                    const held = Sync.push('/a');
+                    TestCase.assertEqual(worker.metrics().pendingChanges, 1);
+                    const stopped = Sync.removeAllListeners();
+                    TestCase.assertTrue(held.closed);
+                    TestCase.assertEqual(worker.metrics().pendingChanges, 0);
+
+                    child.reply();
+                    child.reply();
+                    TestCase.assertEqual(child.sent[child.sent.length - 1].message, 'stop');
+                    child.emit('exit', 0);
+                    return stopped;
+                });
+        });
+    },
+
+    testWorkerReassignsMessagesOnExit: function() {
+        return withStubWorker({maxWorkers: 2}, (worker, children) => {
+            const inFlight = createChange('/a');
+            const waiting = createChange('/a');
+            worker.onchange(inFlight);
+            worker.onchange(createChange('/b'));
+            worker.onchange(waiting);
+
+            const [first, second] = children;
+            const error = console.error;
+            console.error = () => {};
+            try {
+                first.emit('exit', 1, null);
+            }
+            finally {
+                console.error = error;
+            }
+
+            // The change in flight is released, and the waiting one goes to a new child, since the
+            // only other one is busy.
+            TestCase.assertEqual(inFlight.released, 1);
+            TestCase.assertEqual(children.length, 3);
+            TestCase.assertArraysEqual(sentPaths(second), ['/b']);
+            TestCase.assertArraysEqual(sentPaths(children[2]), ['/a']);
+            children[2].reply();
+            TestCase.assertEqual(waiting.released, 1);
+            TestCase.assertArraysEqual(worker.metrics().children.map(c => c.pid), [1, 2]);
+        });
+    },
+};
@@ -555,5 +555,144 @@ module.exports = {
             obj._setLink('stringLink', 'c');
             TestCase.assertEqual(obj.stringLink, null);
         });
+    },
+
+    testObjectListener: function() {
+        if (typeof navigator !== 'undefined' && /Chrome/.test(navigator.userAgent)) { // eslint-disable-line no-undef
+            // FIXME: async callbacks do not work correctly in Chrome debugging mode
+            return Promise.resolve();
+        }
+
+        const realm = new Realm({schema: [schemas.PersonObject]});
+        let person;
+        realm.write(() => {
+            person = realm.create('PersonObject', {name: 'Alice', age: 30});
+        });
+
+        TestCase.assertThrowsContaining(() => person.addListener(() => {}, {keyPaths: ['height']}),
+                                        "Property 'height' of key path 'height' does not exist");
+
+        return new Promise((resolve, reject) => {
+            let calls = 0;
+            person.addListener((object, changes) => {
+                try {
+                    switch (calls++) {
+                        case 0:
+                            TestCase.assertFalse(changes.deleted);
+                            TestCase.assertEqual(changes.changedProperties.length, 0);
+                            realm.write(() => {
+                                person.age = 31;
+                            });
+                            break;
+                        case 1:
+                            TestCase.assertFalse(changes.deleted);
+                            TestCase.assertArraysEqual(changes.changedProperties, ['age']);
+                            realm.write(() => {
+                                realm.delete(person);
+                            });
+                            break;
+                        case 2:
+                            TestCase.assertTrue(changes.deleted);
+                            object.removeAllListeners();
+                            resolve();
+                            break;
+                    }
+                } catch (e) {
+                    reject(e);
+                }
+            });
+        });
+    },
+
+    testObjectListenerKeyPaths: function() {
+        if (typeof navigator !== 'undefined' && /Chrome/.test(navigator.userAgent)) { // eslint-disable-line no-undef
+            // FIXME: async callbacks do not work correctly in Chrome debugging mode
+            return Promise.resolve();
+        }
+
+        const realm = new Realm({schema: [schemas.PersonObject]});
+        let person;
+        realm.write(() => {
+            person = realm.create('PersonObject', {name: 'Alice', age: 30});
+        });
+
+        TestCase.assertThrowsContaining(() => person.addListener(() => {}, {keyPaths: ['age.years']}),
+                                        "Key path 'age.years' continues past the non-link property");
+
+        return new Promise((resolve, reject) => {
+            let calls = 0;
+            person.addListener((object, changes) => {
+                try {
+                    switch (calls++) {
+                        case 0:
+                            // The change to the unwatched 'name' must not be delivered, so the next call
+                            // is for 'age' alone.
+                            realm.write(() => {
+                                person.name = 'Bob';
+                            });
+                            setTimeout(() => {
+                                realm.write(() => {
+                                    person.age = 31;
+                                });
+                            }, 100);
+                            break;
+                        case 1:
+                            TestCase.assertFalse(changes.deleted);
+                            TestCase.assertArraysEqual(changes.changedProperties, ['age']);
+                            object.removeAllListeners();
+                            resolve();
+                            break;
+                    }
+                } catch (e) {
+                    reject(e);
+                }
+            }, {keyPaths: ['age', 'children.name']});
+        });
+    },
+
+    testObjectListenerNotificationBudget: function() {
+        if (typeof navigator !== 'undefined' && /Chrome/.test(navigator.userAgent)) { // eslint-disable-line no-undef
+            // FIXME: async callbacks do not work correctly in Chrome debugging mode
+            return Promise.resolve();
+        }
+
+        const realm = new Realm({schema: [schemas.PersonObject]});
+        let person;
+        realm.write(() => {
+            person = realm.create('PersonObject', {name: 'Alice', age: 30});
+        });
+        Realm.setNotificationBudget(0.001);
+
+        // Whether the two writes arrive as one notification or are merged while the listener waits
+        // for its turn, both changed properties must be reported.
+        const changed = new Set();
+        return new Promise((resolve, reject) => {
+            let calls = 0;
+            person.addListener((object, changes) => {
+                try {
+                    if (calls++ === 0) {
+                        realm.write(() => {
+                            person.age = 31;
+                        });
+                        realm.write(() => {
+                            person.name = 'Bob';
+                        });
+                        setTimeout(resolve, 500);
+                        return;
+                    }
+                    TestCase.assertTrue(changes.changedProperties.length > 0);
+                    changes.changedProperties.forEach((name) => changed.add(name));
+                } catch (e) {
+                    reject(e);
+                }
+            });
+        }).then(() => {
+            Realm.setNotificationBudget(0);
+            person.removeAllListeners();
+            TestCase.assertArraysEqual(Array.from(changed).sort(), ['age', 'name']);
+        }, (e) => {
+            Realm.setNotificationBudget(0);
+            throw e;
+        });
     }
 };
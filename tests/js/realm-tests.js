@@ -764,6 +764,119 @@ module.exports = {
                                         "Object type 'InvalidClass' not found in schema.");
     },
 
+    testBatchListener: function() {
+        if (typeof navigator !== 'undefined' && /Chrome/.test(navigator.userAgent)) { // eslint-disable-line no-undef
+            // FIXME: async callbacks do not work correctly in Chrome debugging mode
+            return Promise.resolve();
+        }
+
+        const realm = new Realm({schema: [schemas.TestObject, schemas.PersonObject]});
+        let person;
+        realm.write(() => {
+            realm.create('TestObject', {doubleCol: 1});
+            person = realm.create('PersonObject', {name: 'Alice', age: 30});
+        });
+
+        const objects = realm.objects('TestObject');
+        const people = realm.objects('PersonObject');
+        const callback = () => {};
+        TestCase.assertThrowsContaining(() => realm.addBatchListener(callback, [{}]),
+                                        'Batch listeners can only observe Realm objects, results and lists.');
+
+        return new Promise((resolve, reject) => {
+            const listener = (sender, changes) => {
+                try {
+                    TestCase.assertEqual(sender.path, realm.path);
+                    TestCase.assertEqual(changes.length, 3);
+                    const byObject = (object) => changes.find((change) => change.object === object).changes;
+                    TestCase.assertEqual(byObject(objects).insertions.length, 1);
+                    TestCase.assertEqual(byObject(people).modifications.length, 1);
+                    TestCase.assertArraysEqual(byObject(person).changedProperties, ['age']);
+                    realm.removeBatchListener(listener);
+                    resolve();
+                } catch (e) {
+                    reject(e);
+                }
+            };
+            realm.addBatchListener(listener, [objects, people, person]);
+
+            setTimeout(() => {
+                realm.write(() => {
+                    realm.create('TestObject', {doubleCol: 2});
+                    person.age = 31;
+                });
+            }, 100);
+        });
+    },
+
+    testBatchListenerMergesVersions: function() {
+        if (typeof navigator !== 'undefined' && /Chrome/.test(navigator.userAgent)) { // eslint-disable-line no-undef
+            // FIXME: async callbacks do not work correctly in Chrome debugging mode
+            return Promise.resolve();
+        }
+
+        const realm = new Realm({schema: [schemas.TestObject]});
+        const objects = realm.objects('TestObject');
+
+        return new Promise((resolve, reject) => {
+            let insertions = 0;
+            const listener = (sender, changes) => {
+                try {
+                    // Versions delivered before the batch is handed to JS are merged into one entry.
+                    TestCase.assertEqual(changes.length, 1);
+                    TestCase.assertEqual(changes[0].object, objects);
+                    insertions += changes[0].changes.insertions.length;
+                    if (insertions === 3) {
+                        realm.removeBatchListener(listener);
+                        resolve();
+                    }
+                } catch (e) {
+                    reject(e);
+                }
+            };
+            realm.addBatchListener(listener, [objects]);
+
+            setTimeout(() => {
+                // Beginning each write delivers the notifications for the previous one.
+                for (let i = 0; i < 3; i++) {
+                    realm.write(() => {
+                        realm.create('TestObject', {doubleCol: i});
+                    });
+                }
+            }, 100);
+        });
+    },
+
+    testNotificationsThrottle: function() {
+        if (typeof navigator !== 'undefined' && /Chrome/.test(navigator.userAgent)) { // eslint-disable-line no-undef
+            // FIXME: async callbacks do not work correctly in Chrome debugging mode
+            return Promise.resolve();
+        }
+
+        const realm = new Realm({schema: []});
+        let notificationCount = 0;
+        realm.addListener('change', () => notificationCount++, {throttleMs: 200});
+
+        // The first change is delivered right away, the following ones are merged into one call.
+        realm.write(() => {});
+        TestCase.assertEqual(notificationCount, 1);
+        realm.write(() => {});
+        realm.write(() => {});
+        TestCase.assertEqual(notificationCount, 1);
+
+        return new Promise((resolve, reject) => {
+            setTimeout(() => {
+                try {
+                    TestCase.assertEqual(notificationCount, 2);
+                    realm.removeAllListeners();
+                    resolve();
+                } catch (e) {
+                    reject(e);
+                }
+            }, 400);
+        });
+    },
+
     testNotifications: function() {
         const realm = new Realm({schema: []});
         let notificationCount = 0;
@@ -813,6 +926,42 @@ module.exports = {
                                         'expected error message');
     },
 
+    testNotificationsChangedDuringNotification: function() {
+        const realm = new Realm({schema: []});
+        const calls = [];
+        const listeners = [];
+        for (let i = 0; i < 1000; i++) {
+            listeners.push(() => {
+                calls.push(i);
+                if (i === 0) {
+                    // Removed listeners are not called, and added ones wait for the next change.
+                    realm.removeListener('change', listeners[1]);
+                    realm.addListener('change', added);
+                }
+            });
+            realm.addListener('change', listeners[i]);
+        }
+        function added() {
+            calls.push('added');
+        }
+
+        realm.write(() => {});
+        TestCase.assertEqual(calls.length, 999);
+        TestCase.assertEqual(calls[1], 2);
+        TestCase.assertEqual(calls.indexOf('added'), -1);
+
+        calls.length = 0;
+        realm.write(() => {});
+        TestCase.assertEqual(calls.length, 1000);
+        TestCase.assertEqual(calls[999], 'added');
+
+        listeners.forEach((listener) => realm.removeListener('change', listener));
+        calls.length = 0;
+        realm.write(() => {});
+        TestCase.assertArraysEqual(calls, ['added']);
+        realm.removeAllListeners();
+    },
+
     testSchema: function() {
         const originalSchema = [schemas.TestObject, schemas.AllTypes, schemas.LinkToAllTypes,
                                 schemas.IndexedTypes, schemas.IntPrimary, schemas.PersonObject,
@@ -1044,6 +1193,127 @@ module.exports = {
         TestCase.assertTrue(realm1.compact());
     },
 
+    testCompactAsync: function() {
+        if (typeof navigator !== 'undefined' && /Chrome/.test(navigator.userAgent)) { // eslint-disable-line no-undef
+            // FIXME: background file operations are not supported in Chrome debugging mode
+            return Promise.resolve();
+        }
+
+        const realm = new Realm({schema: [schemas.StringOnly]});
+        realm.write(() => {
+            for (let i = 0; i < 1000; i++) {
+                realm.create('StringOnlyObject', { stringCol: 'ABCDEFG' });
+            }
+        });
+        realm.close();
+
+        let progressCalled = false;
+        return Realm.compactAsync({}, {onProgress: (transferred, transferable) => {
+            progressCalled = true;
+            TestCase.assertTrue(transferred <= transferable);
+        }}).then(compacted => {
+            TestCase.assertTrue(compacted);
+            TestCase.assertTrue(progressCalled);
+
+            const realm2 = new Realm({schema: [schemas.StringOnly]});
+            TestCase.assertEqual(realm2.objects('StringOnlyObject').length, 1000);
+            realm2.close();
+        });
+    },
+
+    testWriteCopyToAsync: function() {
+        if (typeof navigator !== 'undefined' && /Chrome/.test(navigator.userAgent)) { // eslint-disable-line no-undef
+            // FIXME: background file operations are not supported in Chrome debugging mode
+            return Promise.resolve();
+        }
+
+        const realm = new Realm({schema: [schemas.TestObject]});
+        realm.write(() => {
+            realm.create('TestObject', {doubleCol: 1});
+        });
+
+        const copyPath = Realm.defaultPath + '.async-copy';
+        return realm.writeCopyToAsync(copyPath).then(result => {
+            TestCase.assertTrue(result);
+            realm.close();
+
+            const copy = new Realm({path: copyPath, schema: [schemas.TestObject]});
+            TestCase.assertEqual(copy.objects('TestObject').length, 1);
+            copy.close();
+            Realm.deleteFile({path: copyPath});
+        });
+    },
+
+    testFileOperationOrder: function() {
+        if (typeof navigator !== 'undefined' && /Chrome/.test(navigator.userAgent)) { // eslint-disable-line no-undef
+            // FIXME: background file operations are not supported in Chrome debugging mode
+            return Promise.resolve();
+        }
+
+        const realm = new Realm({schema: [schemas.TestObject]});
+        realm.write(() => {
+            realm.create('TestObject', {doubleCol: 1});
+        });
+
+        const paths = [1, 2, 3].map(i => `${Realm.defaultPath}.ordered-copy-${i}`);
+        const completed = [];
+        const copies = paths.map((path, i) => realm.writeCopyToAsync(path).then(
+            () => completed.push(i),
+            (e) => completed.push(e.message)));
+
+        const promises = paths.map(path => realm.writeCopyToAsync(path + '-b'));
+        TestCase.assertTrue(promises[1].cancel());
+        const results = promises.map((promise, i) => promise.then(() => i, (e) => e.message));
+
+        return Promise.all(copies.concat(results)).then(values => {
+            TestCase.assertArraysEqual(completed, [0, 1, 2]);
+            TestCase.assertArraysEqual(values.slice(3), [0, 'Operation was cancelled.', 2]);
+            TestCase.assertFalse(promises[0].cancel());
+            realm.close();
+            for (const path of paths) {
+                Realm.deleteFile({path});
+                Realm.deleteFile({path: path + '-b'});
+            }
+        });
+    },
+
+    testThreadSafeReference: function() {
+        const realm = new Realm({schema: [schemas.TestObject]});
+        realm.write(() => {
+            realm.create('TestObject', {doubleCol: 1});
+            realm.create('TestObject', {doubleCol: 2});
+        });
+
+        const object = realm.objects('TestObject')[0];
+        const objectReference = realm.createThreadSafeReference(object);
+        const resultsReference = realm.createThreadSafeReference(realm.objects('TestObject').filtered('doubleCol > 1'));
+        TestCase.assertEqual(resultsReference.type, 'results');
+        TestCase.assertEqual(resultsReference.path, realm.path);
+
+        realm.write(() => {
+            realm.create('TestObject', {doubleCol: 3});
+        });
+
+        const otherRealm = new Realm({schema: [schemas.TestObject], _cache: false});
+        TestCase.assertEqual(otherRealm.resolveThreadSafeReference(objectReference).doubleCol, 1);
+        const results = otherRealm.resolveThreadSafeReference(resultsReference);
+        TestCase.assertEqual(results.length, 2);
+
+        TestCase.assertThrowsContaining(() => otherRealm.resolveThreadSafeReference(objectReference),
+                                        'Thread-safe reference has already been resolved');
+        TestCase.assertFalse(Realm.releaseThreadSafeReference(objectReference));
+
+        const unusedReference = realm.createThreadSafeReference(object);
+        TestCase.assertTrue(Realm.releaseThreadSafeReference(unusedReference));
+        TestCase.assertFalse(Realm.releaseThreadSafeReference(unusedReference));
+        TestCase.assertThrowsContaining(() => otherRealm.resolveThreadSafeReference(unusedReference),
+                                        'Thread-safe reference has already been resolved');
+        realm.write(() => {
+            TestCase.assertThrows(() => realm.createThreadSafeReference(object));
+        });
+        otherRealm.close();
+    },
+
     testRealmDeleteFileDefaultConfigPath: function() {
         const config = {schema: [schemas.TestObject]};
         const realm = new Realm(config);
@@ -476,6 +476,363 @@ module.exports = {
         });
     },
 
+    testAddListenerIndexFormats: function() {
+        if (typeof navigator !== 'undefined' && /Chrome/.test(navigator.userAgent)) { // eslint-disable-line no-undef
+            // FIXME: async callbacks do not work correctly in Chrome debugging mode
+            return Promise.resolve();
+        }
+
+        const realm = new Realm({ schema: [schemas.TestObject] });
+        realm.write(() => {
+            for (let i = 0; i < 10; i++) {
+                realm.create('TestObject', { doubleCol: i });
+            }
+        });
+
+        const objects = realm.objects('TestObject');
+        TestCase.assertThrowsContaining(() => objects.addListener(() => {}, { indexFormat: 'bits' }),
+                                        "Unknown index format 'bits'");
+
+        let resolve = () => {};
+        let pending = 2;
+        const done = () => {
+            if (--pending === 0) {
+                objects.removeAllListeners();
+                resolve();
+            }
+        };
+
+        let firstUint32 = true;
+        objects.addListener((collection, changes) => {
+            TestCase.assertTrue(changes.deletions instanceof Uint32Array);
+            if (firstUint32) {
+                firstUint32 = false;
+                return;
+            }
+            TestCase.assertArraysEqual(Array.from(changes.deletions), [0, 1, 2, 3, 4, 5, 6, 7, 8, 9]);
+            TestCase.assertEqual(changes.insertions.length, 0);
+            done();
+        }, { indexFormat: 'uint32' });
+
+        let firstRanges = true;
+        objects.addListener((collection, changes) => {
+            TestCase.assertTrue(changes.deletions instanceof Uint32Array);
+            if (firstRanges) {
+                firstRanges = false;
+                return;
+            }
+            TestCase.assertArraysEqual(Array.from(changes.deletions), [0, 10]);
+            done();
+        }, { indexFormat: 'ranges' });
+
+        return new Promise((r, _reject) => {
+            resolve = r;
+            setTimeout(() => {
+                realm.write(() => {
+                    realm.delete(objects);
+                });
+            }, 100);
+        });
+    },
+
+    testAddListenerKeyPaths: function() {
+        const realm = new Realm({ schema: [schemas.PersonObject] });
+        const people = realm.objects('PersonObject');
+
+        // Collection change sets do not say which properties changed.
+        TestCase.assertThrowsContaining(() => people.addListener(() => {}, { keyPaths: ['age'] }),
+                                        "'keyPaths' is only supported by object listeners.");
+    },
+
+    testAddListenerDebounce: function() {
+        if (typeof navigator !== 'undefined' && /Chrome/.test(navigator.userAgent)) { // eslint-disable-line no-undef
+            // FIXME: async callbacks do not work correctly in Chrome debugging mode
+            return Promise.resolve();
+        }
+
+        const realm = new Realm({ schema: [schemas.TestObject] });
+        const objects = realm.objects('TestObject');
+        TestCase.assertThrowsContaining(() => objects.addListener(() => {}, { debounceMs: -1 }),
+                                        "'debounceMs' must not be negative.");
+
+        return new Promise((resolve, reject) => {
+            let calls = 0;
+            objects.addListener((collection, changes) => {
+                try {
+                    if (calls++ === 0) {
+                        TestCase.assertEqual(changes.insertions.length, 0);
+                        let writes = 0;
+                        const write = () => {
+                            realm.write(() => realm.create('TestObject', { doubleCol: writes }));
+                            if (++writes < 3) {
+                                setTimeout(write, 20);
+                            }
+                        };
+                        write();
+                        return;
+                    }
+                    TestCase.assertEqual(calls, 2);
+                    TestCase.assertArraysEqual(changes.insertions, [0, 1, 2]);
+                    objects.removeAllListeners();
+                    resolve();
+                } catch (e) {
+                    reject(e);
+                }
+            }, { debounceMs: 300 });
+        });
+    },
+
+    testAddListenerThrottle: function() {
+        if (typeof navigator !== 'undefined' && /Chrome/.test(navigator.userAgent)) { // eslint-disable-line no-undef
+            // FIXME: async callbacks do not work correctly in Chrome debugging mode
+            return Promise.resolve();
+        }
+
+        const realm = new Realm({ schema: [schemas.TestObject] });
+        const objects = realm.objects('TestObject');
+        TestCase.assertThrowsContaining(() => objects.addListener(() => {}, { throttleMs: -1 }),
+                                        "'throttleMs' must not be negative.");
+
+        return new Promise((resolve, reject) => {
+            let calls = 0;
+            let leadingCall;
+            objects.addListener((collection, changes) => {
+                try {
+                    switch (calls++) {
+                        case 0:
+                            realm.write(() => realm.create('TestObject', { doubleCol: 0 }));
+                            break;
+                        case 1: {
+                            // The first change is delivered right away.
+                            TestCase.assertArraysEqual(changes.insertions, [0]);
+                            leadingCall = Date.now();
+                            let writes = 1;
+                            const write = () => {
+                                realm.write(() => realm.create('TestObject', { doubleCol: writes }));
+                                if (++writes < 3) {
+                                    setTimeout(write, 20);
+                                }
+                            };
+                            write();
+                            break;
+                        }
+                        case 2:
+                            // Changes within the interval are merged and delivered once it has passed.
+                            TestCase.assertArraysEqual(changes.insertions, [1, 2]);
+                            TestCase.assertTrue(Date.now() - leadingCall >= 150);
+                            objects.removeAllListeners();
+                            resolve();
+                            break;
+                    }
+                } catch (e) {
+                    reject(e);
+                }
+            }, { throttleMs: 200 });
+        });
+    },
+
+    testAddListenerDebounceWithThrottle: function() {
+        if (typeof navigator !== 'undefined' && /Chrome/.test(navigator.userAgent)) { // eslint-disable-line no-undef
+            // FIXME: async callbacks do not work correctly in Chrome debugging mode
+            return Promise.resolve();
+        }
+
+        const realm = new Realm({ schema: [schemas.TestObject] });
+        const objects = realm.objects('TestObject');
+        const totalWrites = 15;
+
+        return new Promise((resolve, reject) => {
+            let calls = 0;
+            let writes = 0;
+            let insertions = 0;
+            let callsDuringWrites = 0;
+            const write = () => {
+                realm.write(() => realm.create('TestObject', { doubleCol: writes }));
+                if (++writes < totalWrites) {
+                    setTimeout(write, 40);
+                }
+            };
+
+            objects.addListener((collection, changes) => {
+                try {
+                    if (calls++ === 0) {
+                        write();
+                        return;
+                    }
+                    // Writes every 40ms never leave the debounce interval quiet, so only the throttle
+                    // interval gets the listener called before they stop.
+                    if (writes < totalWrites) {
+                        callsDuringWrites++;
+                    }
+                    insertions += changes.insertions.length;
+                    if (insertions === totalWrites) {
+                        TestCase.assertTrue(callsDuringWrites >= 1);
+                        objects.removeAllListeners();
+                        resolve();
+                    }
+                } catch (e) {
+                    reject(e);
+                }
+            }, { debounceMs: 100, throttleMs: 250 });
+        });
+    },
+
+    testNotificationBudget: function() {
+        if (typeof navigator !== 'undefined' && /Chrome/.test(navigator.userAgent)) { // eslint-disable-line no-undef
+            // FIXME: async callbacks do not work correctly in Chrome debugging mode
+            return Promise.resolve();
+        }
+
+        TestCase.assertThrowsContaining(() => Realm.setNotificationBudget(-1), "'budgetMs' must not be negative.");
+
+        const realm = new Realm({ schema: [schemas.TestObject] });
+        const low = realm.objects('TestObject');
+        const high = realm.objects('TestObject').filtered('doubleCol >= 0');
+        const deferred = Realm.notificationMetrics().deferred;
+        Realm.setNotificationBudget(0.001);
+
+        return new Promise((resolve, reject) => {
+            const calls = [];
+            let initial = 0;
+            const listener = (name) => (collection, changes) => {
+                try {
+                    if (changes.insertions.length === 0) {
+                        if (++initial === 2) {
+                            realm.write(() => realm.create('TestObject', { doubleCol: 1 }));
+                        }
+                        return;
+                    }
+                    calls.push(name);
+                    if (calls.length === 2) {
+                        TestCase.assertArraysEqual(calls, ['high', 'low']);
+                        TestCase.assertTrue(Realm.notificationMetrics().deferred > deferred);
+                        resolve();
+                    }
+                } catch (e) {
+                    reject(e);
+                }
+            };
+            low.addListener(listener('low'));
+            high.addListener(listener('high'), { priority: 1 });
+        }).then(() => {
+            Realm.setNotificationBudget(0);
+            low.removeAllListeners();
+            high.removeAllListeners();
+        }, (e) => {
+            Realm.setNotificationBudget(0);
+            throw e;
+        });
+    },
+
+    testAddWeakListener: function() {
+        if (typeof navigator !== 'undefined' && /Chrome/.test(navigator.userAgent)) { // eslint-disable-line no-undef
+            // FIXME: async callbacks do not work correctly in Chrome debugging mode
+            return Promise.resolve();
+        }
+
+        const realm = new Realm({ schema: [schemas.TestObject] });
+        const objects = realm.objects('TestObject');
+        TestCase.assertThrowsContaining(() => objects.addListener(() => {}, { weak: 1 }), 'weak');
+
+        // The promise chain keeps the weakly held listener and collection alive until the test ends.
+        let listener;
+        return new Promise((resolve, reject) => {
+            let calls = 0;
+            listener = (collection, changes) => {
+                try {
+                    TestCase.assertEqual(collection, objects);
+                    if (calls++ === 0) {
+                        realm.write(() => realm.create('TestObject', { doubleCol: 1 }));
+                        return;
+                    }
+                    TestCase.assertArraysEqual(changes.insertions, [0]);
+                    objects.removeListener(listener);
+                    realm.write(() => realm.create('TestObject', { doubleCol: 2 }));
+                    setTimeout(() => {
+                        TestCase.assertEqual(calls, 2);
+                        resolve();
+                    }, 100);
+                } catch (e) {
+                    reject(e);
+                }
+            };
+            objects.addListener(listener, { weak: true });
+        }).then(() => objects.removeListener(listener));
+    },
+
+    testResultsWindow: function() {
+        const realm = new Realm({ schema: [schemas.TestObject] });
+        realm.write(() => {
+            for (let i = 0; i < 10; i++) {
+                realm.create('TestObject', { doubleCol: i });
+            }
+        });
+
+        const objects = realm.objects('TestObject').sorted('doubleCol');
+        TestCase.assertThrowsContaining(() => objects.window(-1, 3), "'start' must be a non-negative integer.");
+        TestCase.assertThrowsContaining(() => objects.window(0, 1.5), "'count' must be a non-negative integer.");
+        TestCase.assertThrowsContaining(() => objects.window(0, 1e300), "'count' must not be greater than 4294967295.");
+        TestCase.assertThrowsContaining(() => objects.window(Math.pow(2, 32), 1), "'start' must not be greater than 4294967295.");
+
+        const window = objects.window(2, 3);
+        TestCase.assertTrue(window instanceof Realm.Results.Window);
+        TestCase.assertEqual(window.start, 2);
+        TestCase.assertEqual(window.count, 3);
+        TestCase.assertEqual(window.length, 3);
+        TestCase.assertEqual(window[0].doubleCol, 2);
+        TestCase.assertEqual(window[2].doubleCol, 4);
+        TestCase.assertEqual(window[3], undefined);
+
+        window.move(8);
+        TestCase.assertEqual(window.start, 8);
+        TestCase.assertEqual(window.count, 3);
+        TestCase.assertEqual(window.length, 2);
+        TestCase.assertEqual(window[1].doubleCol, 9);
+
+        window.move(12, 5);
+        TestCase.assertEqual(window.length, 0);
+        TestCase.assertEqual(window[0], undefined);
+        TestCase.assertThrowsContaining(() => window.move(Infinity), "'start' must not be greater than 4294967295.");
+        window.move(4294967295, 4294967295);
+        TestCase.assertEqual(window.length, 0);
+        TestCase.assertEqual(window.start, 4294967295);
+        window.move(2, 3);
+
+        TestCase.assertThrowsContaining(() => window.addListener(() => {}, { keyPaths: ['doubleCol'] }),
+                                        "Window listeners do not support");
+
+        if (typeof navigator !== 'undefined' && /Chrome/.test(navigator.userAgent)) { // eslint-disable-line no-undef
+            // FIXME: async callbacks do not work correctly in Chrome debugging mode
+            return Promise.resolve();
+        }
+
+        return new Promise((resolve, reject) => {
+            let calls = 0;
+            window.addListener((collection, changes) => {
+                try {
+                    TestCase.assertEqual(collection, window);
+                    if (calls++ === 0) {
+                        TestCase.assertEqual(changes.insertions.length, 0);
+                        // Appended after the window, so the listener is not called for it.
+                        realm.write(() => realm.create('TestObject', { doubleCol: 20 }));
+                        setTimeout(() => {
+                            realm.write(() => realm.create('TestObject', { doubleCol: 2.5 }));
+                        }, 100);
+                        return;
+                    }
+                    TestCase.assertEqual(calls, 2);
+                    TestCase.assertArraysEqual(changes.insertions, [1]);
+                    TestCase.assertArraysEqual(changes.deletions, [2]);
+                    TestCase.assertEqual(window[1].doubleCol, 2.5);
+                    window.removeAllListeners();
+                    resolve();
+                } catch (e) {
+                    reject(e);
+                }
+            });
+        });
+    },
+
     testResultsAggregateFunctions: function() {
         var realm = new Realm({ schema: [schemas.NullableBasicTypes] });
         const N = 50;
@@ -506,6 +863,37 @@ module.exports = {
         TestCase.assertEqual(results.max('dateCol').getTime(), new Date(N).getTime());
     },
 
+    testResultsAggregateFunctionsParallel: function() {
+        var realm = new Realm({ schema: [schemas.NullableBasicTypes] });
+        const N = 300000;
+        realm.write(() => {
+            for(var i = 0; i < N; i++) {
+                realm.create('NullableBasicTypesObject', {
+                    intCol: i+1,
+                    floatCol: i % 100,
+                    doubleCol: i+1,
+                });
+            }
+        });
+
+        var results = realm.objects('NullableBasicTypesObject');
+        var filtered = results.filtered('intCol > 100');
+        [results, filtered].forEach(collection => {
+            ['min', 'max', 'sum', 'avg'].forEach(func => {
+                ['intCol', 'floatCol', 'doubleCol'].forEach(colName => {
+                    TestCase.assertEqual(collection[func](colName, { parallel: true }), collection[func](colName));
+                });
+            });
+            TestCase.assertEqual(collection.count({ parallel: true }), collection.length);
+            TestCase.assertEqual(collection.count(), collection.length);
+        });
+        TestCase.assertEqual(results.filtered('floatCol < 10').count({ parallel: true }), N / 10);
+
+        realm.write(() => {
+            TestCase.assertEqual(results.sum('intCol', { parallel: true }), N*(N+1)/2);
+        });
+    },
+
     testResultsAggregateFunctionsWithNullColumnValues: function() {
         var realm = new Realm({ schema: [schemas.NullableBasicTypes] });
 
@@ -889,6 +1277,42 @@ module.exports = {
             results.update('stringCol', 'world');
         });
 
+        realm.close();
+    },
+
+    testResultsBatchedRowsReleasedAfterWrite: function() {
+        if (!Realm._debugHeldObjectCount) {
+            // Only the Chrome debugging client holds objects on the RPC server.
+            return;
+        }
+
+        const N = 120;
+        const realm = new Realm({schema: [schemas.TestObject]});
+        realm.write(() => {
+            for (let i = 0; i < N; i++) {
+                realm.create('TestObject', {doubleCol: i});
+            }
+        });
+
+        const objects = realm.objects('TestObject');
+        const first = objects[0];
+        const iterate = () => {
+            for (let i = 0; i < objects.length; i++) {
+                objects[i].doubleCol;
+            }
+        };
+
+        // Each iteration holds every object once for its wrapper and once for the cached rows. Wrappers
+        // are only released once they are collected, which cannot happen while the test runs, but the
+        // rows read before the write are released when they are replaced.
+        const before = Realm._debugHeldObjectCount();
+        iterate();
+        realm.write(() => {
+            first.doubleCol = -1;
+        });
+        iterate();
+        TestCase.assertTrue(Realm._debugHeldObjectCount() - before <= 3 * N);
+
         realm.close();
     }
 };
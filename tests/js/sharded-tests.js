@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2018 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+'use strict';
+
+var Realm = require('realm');
+var TestCase = require('./asserts');
+var schemas = require('./schemas');
+
+function openSharded() {
+    return new Realm.Sharded({
+        schema: [schemas.IntPrimary],
+        shardCount: 3,
+        shardKey: (objectType, properties) => properties.primaryCol,
+    });
+}
+
+module.exports = {
+    testShardedInvalidConfig: function() {
+        TestCase.assertThrowsContaining(() => new Realm.Sharded({schema: [schemas.IntPrimary], shardKey: () => 0}),
+                                        "'shardCount' must be a positive integer.");
+        TestCase.assertThrowsContaining(() => new Realm.Sharded({schema: [schemas.IntPrimary], shardCount: 2}),
+                                        "'shardKey' must be a function.");
+    },
+
+    testShardedCreateAndLookup: function() {
+        const sharded = openSharded();
+        sharded.write(() => {
+            for (let i = 0; i < 9; i++) {
+                sharded.create('IntPrimaryObject', {primaryCol: i, valueCol: String(i)});
+            }
+        });
+
+        TestCase.assertEqual(sharded.shards.length, 3);
+        sharded.shards.forEach((realm) => TestCase.assertEqual(realm.objects('IntPrimaryObject').length, 3));
+        TestCase.assertEqual(sharded.objectForPrimaryKey('IntPrimaryObject', 4).valueCol, '4');
+        TestCase.assertEqual(sharded.objectForPrimaryKey('IntPrimaryObject', 10), undefined);
+
+        sharded.write(() => {
+            sharded.delete(sharded.objectForPrimaryKey('IntPrimaryObject', 4));
+        });
+        TestCase.assertEqual(sharded.objects('IntPrimaryObject').length, 8);
+        TestCase.assertThrowsContaining(() => sharded.create('IntPrimaryObject', {primaryCol: 20, valueCol: ''}),
+                                        'Can only create or delete objects within a transaction.');
+        TestCase.assertThrowsContaining(() => sharded.shardIndex('IntPrimaryObject', {primaryCol: NaN}),
+                                        "The shard key of the 'IntPrimaryObject' object must be a finite number, got NaN.");
+        TestCase.assertThrowsContaining(() => sharded.shardIndex('IntPrimaryObject', {primaryCol: Infinity}),
+                                        'must be a finite number, got Infinity.');
+        sharded.close();
+    },
+
+    testShardedWriteRollback: function() {
+        const sharded = openSharded();
+        TestCase.assertThrowsContaining(() => {
+            sharded.write(() => {
+                sharded.create('IntPrimaryObject', {primaryCol: 1, valueCol: '1'});
+                throw new Error('rollback');
+            });
+        }, 'rollback');
+        TestCase.assertFalse(sharded.isInTransaction);
+        TestCase.assertEqual(sharded.objects('IntPrimaryObject').length, 0);
+        sharded.close();
+    },
+
+    testShardedQueriesAndAggregates: function() {
+        const sharded = openSharded();
+        sharded.write(() => {
+            for (let i = 0; i < 20; i++) {
+                sharded.create('IntPrimaryObject', {primaryCol: i, valueCol: String(19 - i)});
+            }
+        });
+
+        const results = sharded.objects('IntPrimaryObject').filtered('primaryCol >= 5');
+        TestCase.assertEqual(results.length, 15);
+        TestCase.assertEqual(results.min('primaryCol'), 5);
+        TestCase.assertEqual(results.max('primaryCol'), 19);
+        TestCase.assertEqual(results.sum('primaryCol'), 180);
+        TestCase.assertEqual(results.avg('primaryCol'), 12);
+
+        const sorted = results.sorted('primaryCol', true);
+        TestCase.assertArraysEqual(sorted.slice(0, 4).map((object) => object.primaryCol), [19, 18, 17, 16]);
+        TestCase.assertArraysEqual(sorted.slice(-2).map((object) => object.primaryCol), [6, 5]);
+        TestCase.assertEqual(sorted.toArray().length, 15);
+        sharded.close();
+    },
+};
@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2018 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/* eslint-env es6, node */
+
+'use strict';
+
+const Realm = require('realm');
+const TestCase = require('./asserts');
+const schemas = require('./schemas');
+
+// Uses the gc() exposed by --expose-gc, or enables it at runtime.
+function getGC() {
+    if (typeof global.gc === 'function') {
+        return global.gc;
+    }
+    require('v8').setFlagsFromString('--expose-gc');
+    return require('vm').runInNewContext('gc');
+}
+
+function nextTurn(ms) {
+    return new Promise((resolve) => setTimeout(resolve, ms || 0));
+}
+
+// Collects garbage until the referenced object is gone, or a few times if it cannot be told.
+function collect(gc, reference, attempts) {
+    gc();
+    if (attempts <= 1 || (reference && !reference.deref())) {
+        return nextTurn(10);
+    }
+    return nextTurn(10).then(() => collect(gc, reference, attempts - 1));
+}
+
+// Adds a weak listener whose function is only referenced by the returned WeakRef, if there is one.
+function addWeakListener(objects, calls) {
+    const listener = () => calls.count++;
+    objects.addListener(listener, { weak: true });
+    return typeof WeakRef !== 'undefined' ? new WeakRef(listener) : null;
+}
+
+module.exports = {
+    testWeakListenerPurgedAfterCollection: function() {
+        const gc = getGC();
+        const realm = new Realm({ schema: [schemas.TestObject] });
+        const objects = realm.objects('TestObject');
+
+        // A strong listener on the same collection tells how many deliveries a single listener makes.
+        const weakCalls = { count: 0 };
+        let strongCalls = 0;
+        const reference = addWeakListener(objects, weakCalls);
+        objects.addListener(() => strongCalls++);
+
+        let delivered;
+
+        // Wait for the initial notifications, then collect the weak listener's function and give the
+        // purge scheduled by its collection a turn of the event loop to run.
+        return nextTurn(100)
+            .then(() => {
+                TestCase.assertEqual(weakCalls.count, 1);
+                return collect(gc, reference, reference ? 10 : 3);
+            })
+            .then(() => {
+                if (reference) {
+                    TestCase.assertUndefined(reference.deref());
+                }
+                delivered = Realm.notificationMetrics().delivered;
+                realm.write(() => realm.create('TestObject', { doubleCol: 1 }));
+                return nextTurn(100);
+            })
+            .then(() => {
+                TestCase.assertEqual(strongCalls, 2);
+                TestCase.assertEqual(weakCalls.count, 1);
+                // Only the strong listener's notifier is left to deliver anything.
+                TestCase.assertEqual(Realm.notificationMetrics().delivered - delivered, 1);
+                objects.removeAllListeners();
+            });
+    },
+};
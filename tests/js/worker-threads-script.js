@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2018 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/* eslint-env es6, node */
+
+'use strict';
+
+const { parentPort, workerData } = require('worker_threads');
+const Realm = require(workerData.realmModule);
+
+const realm = new Realm(workerData.config);
+realm.write(() => {
+    for (const value of workerData.values) {
+        realm.create(workerData.type, value);
+    }
+});
+
+const objects = realm.objects(workerData.type);
+parentPort.postMessage({
+    count: objects.length,
+    isRealmObject: objects[0] instanceof Realm.Object,
+    isResults: objects instanceof Realm.Results,
+});
+
+if (workerData.leaveOpen) {
+    // Exit without closing the Realm once the test says so, which leaves it to the addon's cleanup hook.
+    parentPort.on('message', () => process.exit(0));
+}
+else {
+    realm.close();
+}
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2018 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/* eslint-env es6, node */
+/* global REALM_MODULE_PATH */
+
+'use strict';
+
+const Realm = require('realm');
+const TestCase = require('./asserts');
+const schemas = require('./schemas');
+const { Worker } = require('worker_threads');
+
+// Runs worker-threads-script.js, which opens the Realm, creates `values` and reports what it sees.
+function startWorker(config, values, leaveOpen) {
+    const worker = new Worker(__dirname + '/worker-threads-script.js', {
+        workerData: {
+            realmModule: REALM_MODULE_PATH,
+            config,
+            type: 'TestObject',
+            values,
+            leaveOpen: !!leaveOpen,
+        }
+    });
+    const message = new Promise((resolve, reject) => {
+        worker.once('message', resolve);
+        worker.once('error', reject);
+    });
+    const exit = new Promise((resolve, reject) => {
+        worker.once('exit', code => code === 0 ? resolve() : reject(new Error(`Worker exited with code ${code}`)));
+    });
+    return {worker, message, exit};
+}
+
+module.exports = {
+    testOpenRealmInWorker: function() {
+        const config = {schema: [schemas.TestObject]};
+        const realm = new Realm(config);
+        realm.write(() => realm.create('TestObject', {doubleCol: 1}));
+
+        const {message, exit} = startWorker(config, [{doubleCol: 2}, {doubleCol: 3}]);
+        return message.then(result => {
+            TestCase.assertEqual(result.count, 3);
+            TestCase.assertTrue(result.isRealmObject);
+            TestCase.assertTrue(result.isResults);
+            return exit;
+        }).then(() => {
+            realm.refresh();
+            TestCase.assertEqual(realm.objects('TestObject').length, 3);
+            realm.close();
+        });
+    },
+
+    testConcurrentWorkers: function() {
+        // Each worker has its own isolate and templates, and the main thread's are unaffected by them exiting.
+        const workers = [1, 2, 3].map(i => startWorker({path: `worker-${i}.realm`, schema: [schemas.TestObject]},
+                                                       [{doubleCol: i}]));
+        return Promise.all(workers.map(w => w.message)).then(results => {
+            for (const result of results) {
+                TestCase.assertEqual(result.count, 1);
+                TestCase.assertTrue(result.isRealmObject);
+            }
+            return Promise.all(workers.map(w => w.exit));
+        }).then(() => {
+            const realm = new Realm({path: 'worker-2.realm', schema: [schemas.TestObject]});
+            const objects = realm.objects('TestObject');
+            TestCase.assertTrue(objects instanceof Realm.Results);
+            TestCase.assertTrue(objects[0] instanceof Realm.Object);
+            TestCase.assertEqual(objects[0].doubleCol, 2);
+            realm.close();
+        });
+    },
+
+    testWorkerExitClosesRealms: function() {
+        const config = {schema: [schemas.TestObject]};
+        const realm = new Realm(config);
+
+        const {worker, message, exit} = startWorker(config, [{doubleCol: 1}], true);
+        return message.then(() => {
+            // Compaction is refused while the worker's instance is open.
+            TestCase.assertFalse(realm.compact());
+            worker.postMessage('exit');
+            return exit;
+        }).then(() => {
+            TestCase.assertTrue(realm.compact());
+            realm.close();
+        });
+    },
+};